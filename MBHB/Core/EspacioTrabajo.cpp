@@ -0,0 +1,53 @@
+#include <vector>
+#include <algorithm>
+
+using namespace std;
+
+// Marcador por épocas
+// Sustituye a los vector<bool> "ya usado" que los operadores creaban en cada llamada.
+// Cada marca guarda la época en que se puso; empezar de cero es O(1) (++epoca).
+struct MarcadorEpoca {
+    vector<unsigned int> sello;
+    unsigned int epoca = 0;
+
+    void asegurar(int n) {
+        if ((int)sello.size() < n) sello.resize(n, 0);
+    }
+
+    // Invalida todas las marcas anteriores
+    void nuevaEpoca() {
+        epoca++;
+        if (epoca == 0) { // Desbordamiento (2^32 épocas): limpieza real, muy rara
+            fill(sello.begin(), sello.end(), 0);
+            epoca = 1;
+        }
+    }
+
+    void marcar(int i) { sello[i] = epoca; }
+    bool marcado(int i) const { return sello[i] == epoca; }
+};
+
+// Espacio de trabajo reutilizable para operadores (mutación, cruce, construcción de hormigas...)
+// Los buffers solo crecen: tras la primera llamada con un n dado no hay más reservas de memoria.
+// No es compartible entre hilos: cada hilo debe usar el suyo (ver espacioHilo()).
+struct EspacioTrabajo {
+    vector<int> enteros;
+    vector<int> enteros2;
+    vector<double> reales;
+    MarcadorEpoca marcas;
+    MarcadorEpoca marcas2;
+
+    void reservar(int n) {
+        if ((int)enteros.size() < n) enteros.resize(n);
+        if ((int)enteros2.size() < n) enteros2.resize(n);
+        if ((int)reales.size() < n) reales.resize(n);
+        marcas.asegurar(n);
+        marcas2.asegurar(n);
+    }
+};
+
+// Espacio por defecto de cada hilo (lo usan las firmas antiguas de los operadores)
+EspacioTrabajo& espacioHilo() {
+    thread_local EspacioTrabajo espacio;
+    return espacio;
+}
@@ -1,10 +1,11 @@
 #include <vector>
 #include <iostream>
+#include <atomic>
 
 using namespace std;
 
-// Métrica global de esfuerzo
-long long numEvaluaciones = 0;
+// Métrica global de esfuerzo (atómica: los AG evalúan hijos desde varios hilos)
+atomic<long long> numEvaluaciones{0};
 
 void resetEvaluaciones() {
     numEvaluaciones = 0;
@@ -12,13 +13,13 @@ void resetEvaluaciones() {
 
 // Evaluador de Coste para QAP
 // Coste = Sum(F[i][j] * D[S[i]][S[j]])
-long long evaluarSolucion(const vector<int>& solucion, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
+// Versión sobre puntero: permite evaluar genotipos guardados en bloques contiguos (PoblacionSoA)
+long long evaluarSolucion(const int* solucion, int n, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
     numEvaluaciones++;
     long long coste = 0;
-    size_t n = solucion.size();
     
-    for (size_t i = 0; i < n; i++) {
-        for (size_t j = 0; j < n; j++) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
             if (i != j) {
                 coste += flujo[i][j] * distancia[solucion[i]][solucion[j]];
             }
@@ -27,9 +28,14 @@ long long evaluarSolucion(const vector<int>& solucion, const vector<vector<int>>
     return coste;
 }
 
+long long evaluarSolucion(const vector<int>& solucion, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
+    return evaluarSolucion(solucion.data(), solucion.size(), flujo, distancia);
+}
+
 // Cálculo eficiente del Delta (Diferencia de coste al intercambiar r y s)
 // Complejidad O(n) en vez de O(n^2)
-long long calcularDelta(int r, int s, const vector<int>& solucion, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
+// Versión sobre puntero (genotipos de PoblacionSoA, búsqueda local por matriz de deltas)
+long long calcularDelta(int r, int s, const int* solucion, int n, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
     // Delta también cuenta como evaluación parcial (esfuerzo computacional)
     // numEvaluaciones++; // Descomentar si se quiere contar deltas. Para QAP, el Delta es O(n) y evaluar es O(n^2).
     // Usualmente para comparación justa se cuenta 1 eval completa = N deltas? 
@@ -37,13 +43,12 @@ long long calcularDelta(int r, int s, const vector<int>& solucion, const vector<
     numEvaluaciones++; 
 
     long long delta = 0;
-    size_t n = solucion.size();
     
     // Unidades r y s
     int u_r = solucion[r];
     int u_s = solucion[s];
     
-    for (size_t k = 0; k < n; k++) {
+    for (int k = 0; k < n; k++) {
         if (k != r && k != s) {
             int u_k = solucion[k];
             // Restar contribución antigua
@@ -62,3 +67,35 @@ long long calcularDelta(int r, int s, const vector<int>& solucion, const vector<
     
     return delta;
 }
+
+long long calcularDelta(int r, int s, const vector<int>& solucion, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
+    return calcularDelta(r, s, solucion.data(), solucion.size(), flujo, distancia);
+}
+
+// Delta Multi-posición: coste(despues) - coste(antes) cuando solo difieren las posiciones pos[0..k)
+// Complejidad O(k*n): solo se recalculan los pares (i,j) con i o j en el conjunto cambiado.
+// Las posiciones fuera del conjunto se reconocen porque antes[j] == despues[j].
+long long calcularDeltaMultiple(const int* antes, const int* despues, const int* pos, int k, int n, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
+    numEvaluaciones++; // Misma convención que calcularDelta: un delta cuenta como una evaluación
+    
+    long long delta = 0;
+    for (int t = 0; t < k; t++) {
+        int i = pos[t];
+        int a_i = antes[i];
+        int b_i = despues[i];
+        const vector<int>& flujoI = flujo[i];
+        
+        for (int j = 0; j < n; j++) {
+            if (j == i) continue;
+            int a_j = antes[j];
+            int b_j = despues[j];
+            // Pares (i, j): todos los j
+            delta += flujoI[j] * (distancia[b_i][b_j] - distancia[a_i][a_j]);
+            // Pares (j, i) con j sin cambiar (si j cambió, ya se cuenta como (j, i) en su turno)
+            if (a_j == b_j) {
+                delta += flujo[j][i] * (distancia[b_j][b_i] - distancia[a_j][a_i]);
+            }
+        }
+    }
+    return delta;
+}
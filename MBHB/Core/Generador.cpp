@@ -6,7 +6,9 @@
 using namespace std;
 
 // Generador de Números Aleatorios Global
-mt19937 rng;
+// thread_local: cada hilo tiene su propio flujo (los hilos de trabajo lo siembran por tarea,
+// ver Core/Paralelo.cpp). En el hilo principal se comporta exactamente como antes.
+thread_local mt19937 rng;
 
 void inicializarSemilla(unsigned int seed) {
     if (seed == 0) {
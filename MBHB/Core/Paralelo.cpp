@@ -0,0 +1,121 @@
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <algorithm>
+
+using namespace std;
+
+// Pool de Hilos persistente
+// Los hilos se crean una vez y se reutilizan en cada paraCada(): lanzar hilos por generación
+// costaría más que el trabajo en problemas pequeños. El hilo llamador también trabaja (hilo 0).
+// Las tareas se reparten dinámicamente, así que cada tarea debe ser independiente del hilo que
+// la ejecute: para reproducibilidad, cada tarea resiembra 'rng' (thread_local) con su propia semilla.
+// Asume Core/Generador.cpp incluido antes (rng).
+class PoolHilos {
+public:
+    // numHilos <= 0: tantos como núcleos
+    explicit PoolHilos(int numHilos = 0) {
+        if (numHilos <= 0) numHilos = max(1u, thread::hardware_concurrency());
+        total = numHilos;
+        for (int h = 1; h < total; h++) {
+            trabajadores.emplace_back([this, h]() { bucleTrabajador(h); });
+        }
+    }
+
+    ~PoolHilos() {
+        {
+            lock_guard<mutex> lock(mtx);
+            terminar = true;
+        }
+        cvTrabajo.notify_all();
+        for (auto& t : trabajadores) t.join();
+    }
+
+    PoolHilos(const PoolHilos&) = delete;
+    PoolHilos& operator=(const PoolHilos&) = delete;
+
+    int numHilos() const { return total; }
+
+    // Ejecuta tarea(i, hilo) para i en [0, numTareas) y espera a que terminen todas.
+    // 'hilo' está en [0, numHilos()): sirve para indexar espacios de trabajo por hilo.
+    template <typename Tarea>
+    void paraCada(int numTareas, Tarea& tarea) {
+        if (numTareas <= 0) return;
+
+        // Las tareas resiembran 'rng'; en el hilo llamador se restaura al acabar
+        mt19937 rngLlamador = rng;
+
+        if (total == 1 || numTareas == 1) {
+            for (int i = 0; i < numTareas; i++) tarea(i, 0);
+        } else {
+            {
+                lock_guard<mutex> lock(mtx);
+                funcion = &invocar<Tarea>;
+                contexto = &tarea;
+                tareasTotales = numTareas;
+                siguiente.store(0);
+                pendientes = total - 1;
+                ronda++;
+            }
+            cvTrabajo.notify_all();
+
+            ejecutarTareas(0);
+
+            unique_lock<mutex> lock(mtx);
+            cvFin.wait(lock, [this]() { return pendientes == 0; });
+        }
+
+        rng = rngLlamador;
+    }
+
+private:
+    int total = 1;
+    vector<thread> trabajadores;
+
+    mutex mtx;
+    condition_variable cvTrabajo, cvFin;
+    bool terminar = false;
+    long long ronda = 0;
+    int pendientes = 0;
+
+    // Trabajo actual: puntero a función + contexto (sin std::function, sin reservas de memoria)
+    void (*funcion)(void*, int, int) = nullptr;
+    void* contexto = nullptr;
+    int tareasTotales = 0;
+    atomic<int> siguiente{0};
+
+    template <typename Tarea>
+    static void invocar(void* ctx, int i, int hilo) {
+        (*static_cast<Tarea*>(ctx))(i, hilo);
+    }
+
+    void ejecutarTareas(int hilo) {
+        while (true) {
+            int i = siguiente.fetch_add(1);
+            if (i >= tareasTotales) break;
+            funcion(contexto, i, hilo);
+        }
+    }
+
+    void bucleTrabajador(int hilo) {
+        long long rondaVista = 0;
+        while (true) {
+            {
+                unique_lock<mutex> lock(mtx);
+                cvTrabajo.wait(lock, [&]() { return terminar || ronda != rondaVista; });
+                if (terminar) return;
+                rondaVista = ronda;
+            }
+
+            ejecutarTareas(hilo);
+
+            {
+                lock_guard<mutex> lock(mtx);
+                pendientes--;
+            }
+            cvFin.notify_one();
+        }
+    }
+};
@@ -91,3 +91,97 @@ vector<int> busquedaLocalFirstImprovement(vector<int> solucion, const vector<vec
     
     return solucion;
 }
+
+// --- Matriz de Deltas de Intercambio (Taillard) ---
+// delta[r*n+s] (r < s) = variación de coste al intercambiar r y s en la solución actual.
+// Inicializarla cuesta n(n-1)/2 deltas O(n). Tras aplicar un intercambio (u, v):
+//   - los pares que tocan u o v se recalculan con calcularDelta (2n-3 deltas O(n))
+//   - el resto se actualiza en O(1) con la fórmula de Taillard (p = solución ya intercambiada):
+//     delta(r,s) += (F[r][u]-F[r][v]+F[s][v]-F[s][u]) * (D[p_s][p_u]-D[p_s][p_v]+D[p_r][p_v]-D[p_r][p_u])
+//                 + (F[u][r]-F[v][r]+F[v][s]-F[u][s]) * (D[p_u][p_s]-D[p_v][p_s]+D[p_v][p_r]-D[p_u][p_r])
+// Así cada movimiento de la búsqueda local cuesta O(n^2) en lugar de recorrer el vecindario con deltas O(n).
+struct MatrizDeltasSwap {
+    int n = 0;
+    vector<long long> delta;
+
+    // Devuelve los deltas O(n) calculados (esfuerzo, misma convención que calcularDelta)
+    int inicializar(const int* sol, int tam, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
+        n = tam;
+        if ((int)delta.size() < n * n) delta.resize(n * n);
+        for(int r = 0; r < n; r++) {
+            for(int s = r + 1; s < n; s++) {
+                delta[r * n + s] = calcularDelta(r, s, sol, n, flujo, distancia);
+            }
+        }
+        return n * (n - 1) / 2;
+    }
+
+    long long valor(int r, int s) const { return delta[r * n + s]; }
+
+    // Aplica el intercambio (u, v) sobre 'sol' y actualiza la matriz. Devuelve los deltas O(n) calculados.
+    int aplicar(int* sol, int u, int v, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia) {
+        swap(sol[u], sol[v]);
+        const vector<int>& Fu = flujo[u];
+        const vector<int>& Fv = flujo[v];
+        const vector<int>& Dpu = distancia[sol[u]];
+        const vector<int>& Dpv = distancia[sol[v]];
+        int recalculados = 0;
+
+        for(int r = 0; r < n; r++) {
+            bool rTocado = (r == u || r == v);
+            const vector<int>& Fr = flujo[r];
+            int pr = sol[r];
+            for(int s = r + 1; s < n; s++) {
+                if (rTocado || s == u || s == v) {
+                    delta[r * n + s] = calcularDelta(r, s, sol, n, flujo, distancia);
+                    recalculados++;
+                    continue;
+                }
+                int ps = sol[s];
+                const vector<int>& Fs = flujo[s];
+                long long termino1 = (long long)(Fr[u] - Fr[v] + Fs[v] - Fs[u]) *
+                                     (distancia[ps][sol[u]] - distancia[ps][sol[v]] + distancia[pr][sol[v]] - distancia[pr][sol[u]]);
+                long long termino2 = (long long)(Fu[r] - Fv[r] + Fv[s] - Fu[s]) *
+                                     (Dpu[ps] - Dpv[ps] + Dpv[pr] - Dpu[pr]);
+                delta[r * n + s] += termino1 + termino2;
+            }
+        }
+        return recalculados;
+    }
+};
+
+// --- Estrategia 3: Mejor Vecino acotado sobre la Matriz de Deltas ---
+// Para hibridar con evolutivos (meméticos): mejora 'sol' en su sitio y actualiza 'coste'.
+// Para en óptimo local o cuando el siguiente movimiento superaría 'maxDeltas' deltas O(n)
+// (incluida la inicialización). Devuelve los deltas gastados, para descontarlos del presupuesto.
+// Si se pasa 'optimoLocal', vale true solo si se llegó a un óptimo local (una pasada completa
+// sin swap que mejore); si lo cortó el tope, false.
+int busquedaLocalAcotada(int* sol, int n, long long& coste, const vector<vector<int>>& flujo, const vector<vector<int>>& distancia,
+                         int maxDeltas, MatrizDeltasSwap& matriz, bool* optimoLocal = nullptr) {
+    if (optimoLocal) *optimoLocal = n < 2; // Sin vecindario ya es óptimo
+    if (n < 2 || maxDeltas < n * (n - 1) / 2) return 0; // Ni siquiera alcanza para construir la matriz
+    int usados = matriz.inicializar(sol, n, flujo, distancia);
+    int costeMovimiento = 2 * n - 3;
+
+    while (usados + costeMovimiento <= maxDeltas) {
+        long long mejorDelta = 0;
+        int mejorR = -1, mejorS = -1;
+        for(int r = 0; r < n; r++) {
+            for(int s = r + 1; s < n; s++) {
+                if (matriz.valor(r, s) < mejorDelta) {
+                    mejorDelta = matriz.valor(r, s);
+                    mejorR = r;
+                    mejorS = s;
+                }
+            }
+        }
+        if (mejorR == -1) { // Óptimo local
+            if (optimoLocal) *optimoLocal = true;
+            break;
+        }
+
+        coste += mejorDelta;
+        usados += matriz.aplicar(sol, mejorR, mejorS, flujo, distancia);
+    }
+    return usados;
+}
@@ -1,35 +1,155 @@
 #include <vector>
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Núcleo vectorial: número de posiciones iguales en [0, len)
+// AVX2 compara 8 enteros por instrucción, SSE2 (siempre presente en x86-64) 4.
+// La máscara de cmpeq vale -1 en las posiciones iguales, así que restarla acumula la cuenta.
+int contarIguales(const int* a, const int* b, int len) {
+    int i = 0;
+    int iguales = 0;
+#if defined(__AVX2__)
+    __m256i acc = _mm256_setzero_si256();
+    for(; i + 8 <= len; i += 8) {
+        __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        acc = _mm256_sub_epi32(acc, _mm256_cmpeq_epi32(va, vb));
+    }
+    __m128i acc4 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    acc4 = _mm_add_epi32(acc4, _mm_shuffle_epi32(acc4, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc4 = _mm_add_epi32(acc4, _mm_shuffle_epi32(acc4, _MM_SHUFFLE(2, 3, 0, 1)));
+    iguales = _mm_cvtsi128_si32(acc4);
+#elif defined(__SSE2__)
+    __m128i acc = _mm_setzero_si128();
+    for(; i + 4 <= len; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+        acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(va, vb));
+    }
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+    acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+    iguales = _mm_cvtsi128_si32(acc);
+#endif
+    // Cola escalar (o todo el recorrido si no hay SIMD)
+    for(; i < len; i++) {
+        iguales += (a[i] == b[i]);
+    }
+    return iguales;
+}
+
 // Distancia de Hamming para Permutaciones
 // Devuelve el número de posiciones donde las soluciones difieren.
 // Rango: [0, n] (0 = idénticas, n = totalmente diferentes)
+int distanciaHamming(const int* solA, const int* solB, int n) {
+    return n - contarIguales(solA, solB, n);
+}
+
 int distanciaHamming(const vector<int>& solA, const vector<int>& solB) {
-    int dist = 0;
-    int n = solA.size(); // Asumimos mismo tamaño
+    return distanciaHamming(solA.data(), solB.data(), solA.size()); // Asumimos mismo tamaño
+}
+
+// Variante acotada: ¿distancia > umbral?
+// Recorre por bloques y corta en cuanto la distancia ya supera el umbral
+// o en cuanto, aunque difirieran todas las posiciones restantes, no podría superarlo.
+// Es lo único que necesita el test de incesto de CHC.
+const int BLOQUE_HAMMING = 32;
+
+bool superaDistanciaHamming(const int* solA, const int* solB, int n, int umbral) {
+    if (umbral < 0) return true;
+    if (umbral >= n) return false;
     
-    for(int i = 0; i < n; i++) {
-        if (solA[i] != solB[i]) {
-            dist++;
-        }
+    int dist = 0;
+    for(int i = 0; i < n; i += BLOQUE_HAMMING) {
+        int len = min(BLOQUE_HAMMING, n - i);
+        dist += len - contarIguales(solA + i, solB + i, len);
+        
+        if (dist > umbral) return true;                   // Ya lo supera
+        if (dist + (n - i - len) <= umbral) return false; // Ya no puede superarlo
     }
-    return dist;
+    return false;
 }
 
-// Cálculo de entropía/diversidad de una población (Opcional para Evolutivos)
-double diversidadPoblacion(const vector<vector<int>>& poblacion) {
-    long long sumaDist = 0;
-    int count = 0;
-    int p = poblacion.size();
-    
-    for(int i = 0; i < p; i++) {
-        for(int j = i+1; j < p; j++) {
-            sumaDist += distanciaHamming(poblacion[i], poblacion[j]);
-            count++;
+bool superaDistanciaHamming(const vector<int>& solA, const vector<int>& solB, int umbral) {
+    return superaDistanciaHamming(solA.data(), solB.data(), solA.size(), umbral);
+}
+
+// Matriz de Frecuencias Posición x Valor
+// freq[i*n + v] = número de individuos que tienen el valor v en la posición i.
+// La suma de Hamming sobre todos los pares sale sin comparar pares:
+//   Sum_pares(Hamming) = Sum_i [ C(p,2) - Sum_v C(freq[i][v], 2) ]
+// Se mantiene acumulado el término Sum_i Sum_v C(freq,2) (pares coincidentes),
+// así insertar/eliminar/reemplazar cuesta O(n) y consultar la diversidad O(1).
+struct MatrizFrecuencias {
+    int n = 0;                  // Tamaño del genotipo (y rango de valores)
+    int p = 0;                  // Individuos registrados
+    vector<int> freq;           // n x n aplanada
+    long long paresIguales = 0; // Pares (individuo, individuo, posición) coincidentes
+
+    void inicializar(int tamGenotipo) {
+        n = tamGenotipo;
+        p = 0;
+        paresIguales = 0;
+        freq.assign((size_t)n * n, 0);
+    }
+
+    void insertar(const int* genotipo) {
+        for(int i = 0; i < n; i++) {
+            int& c = freq[(size_t)i * n + genotipo[i]];
+            paresIguales += c; // El nuevo coincide con los c que ya estaban
+            c++;
         }
+        p++;
     }
-    
-    return count > 0 ? (double)sumaDist / count : 0.0;
+
+    void eliminar(const int* genotipo) {
+        for(int i = 0; i < n; i++) {
+            int& c = freq[(size_t)i * n + genotipo[i]];
+            c--;
+            paresIguales -= c;
+        }
+        p--;
+    }
+
+    // Sustituye un individuo por otro: solo tocan las posiciones que cambian
+    void reemplazar(const int* antiguo, const int* nuevo) {
+        for(int i = 0; i < n; i++) {
+            if (antiguo[i] == nuevo[i]) continue;
+            int& cA = freq[(size_t)i * n + antiguo[i]];
+            cA--;
+            paresIguales -= cA;
+            int& cN = freq[(size_t)i * n + nuevo[i]];
+            paresIguales += cN;
+            cN++;
+        }
+    }
+
+    void insertar(const vector<int>& genotipo) { insertar(genotipo.data()); }
+    void eliminar(const vector<int>& genotipo) { eliminar(genotipo.data()); }
+    void reemplazar(const vector<int>& antiguo, const vector<int>& nuevo) { reemplazar(antiguo.data(), nuevo.data()); }
+
+    // Distancia de Hamming media entre todos los pares de individuos
+    double diversidad() const {
+        if (p < 2) return 0.0;
+        long long pares = (long long)p * (p - 1) / 2;
+        long long sumaDist = pares * n - paresIguales;
+        return (double)sumaDist / pares;
+    }
+};
+
+// Cálculo de entropía/diversidad de una población (Opcional para Evolutivos)
+// O(p*n) mediante la matriz de frecuencias (antes O(p^2*n) comparando pares)
+double diversidadPoblacion(const vector<vector<int>>& poblacion) {
+    if (poblacion.size() < 2) return 0.0;
+
+    MatrizFrecuencias frecuencias;
+    frecuencias.inicializar(poblacion[0].size());
+    for(const auto& ind : poblacion) frecuencias.insertar(ind);
+
+    return frecuencias.diversidad();
 }
@@ -17,15 +17,15 @@ vector<int> construccionGreedyAleatorizada(const vector<vector<int>>& flujo, con
     vector<int> solucion(n, -1);
     
     // Calcular Potenciales (recalcualdo cada vez para simplicidad, optimizable)
-    vector<ElementoCandidato> potFlujo(n);
+    vector<Elemento> potFlujo(n);
     for(int i=0; i<n; i++) {
         potFlujo[i].id = i; 
         potFlujo[i].potencial = 0;
         for(int j=0; j<n; j++) potFlujo[i].potencial += flujo[i][j] + flujo[j][i];
     }
-    sort(potFlujo.begin(), potFlujo.end(), comparePotMayor);
+    sort(potFlujo.begin(), potFlujo.end(), compararMayorMenor);
     
-    vector<ElementoCandidato> potDist(n);
+    vector<Elemento> potDist(n);
     for(int k=0; k<n; k++) {
         potDist[k].id = k; 
         potDist[k].potencial = 0;
@@ -33,15 +33,17 @@ vector<int> construccionGreedyAleatorizada(const vector<vector<int>>& flujo, con
     }
     // Para distancia, queremos asociar ALTO flujo con BAJA distancia (Centro)
     // Ordenamos distancias de MENOR a MAYOR (0=Centro, n=Periferia)
-    sort(potDist.begin(), potDist.end(), comparePotMenor); 
+    sort(potDist.begin(), potDist.end(), compararMenorMayor); 
     
     // LRC logic
     vector<bool> locacionOcupada(n, false);
+    vector<Elemento> locacionesDisponibles; // Reutilizado en cada paso (clear no libera)
+    locacionesDisponibles.reserve(n);
     
     for(int i=0; i<n; i++) {
         int unidad = potFlujo[i].id;
         
-        vector<ElementoCandidato> locacionesDisponibles;
+        locacionesDisponibles.clear();
         for(int k=0; k<n; k++) {
             if(!locacionOcupada[potDist[k].id]) locacionesDisponibles.push_back(potDist[k]);
         }
@@ -2,35 +2,44 @@
 #include <algorithm>
 #include <random>
 #include <iostream>
+// Asumimos Core/Generador.cpp y Core/EspacioTrabajo.cpp incluidos en main
 
 using namespace std;
 
 // Operador de Mutación: Sublista Aleatoria
 // Selecciona una sublista de tamaño 's' (circular) y la permuta aleatoriamente.
-void mutarSublista(vector<int>& solucion, int s) {
-    int n = solucion.size();
+// Los valores se barajan en el buffer del espacio de trabajo: sin reservas de memoria por llamada.
+void mutarSublista(int* solucion, int n, int s, EspacioTrabajo& ws) {
     if (s <= 1 || s > n) return; // Validación básica
     
     // Elegir posición inicial aleatoria
     int inicio = aleatorio(0, n - 1);
     
     // Extraer valores de la sublista circular
-    vector<int> valores;
-    valores.reserve(s);
-    vector<int> indices;
-    indices.reserve(s);
+    ws.reservar(s);
+    int* valores = ws.enteros.data();
     
+    int idx = inicio;
     for (int k = 0; k < s; k++) {
-        int idx = (inicio + k) % n; // Circularidad
-        indices.push_back(idx);
-        valores.push_back(solucion[idx]);
+        valores[k] = solucion[idx];
+        if (++idx == n) idx = 0; // Circularidad
     }
     
     // Barajar valores (Shuffle)
-    shuffle(valores.begin(), valores.end(), rng);
+    shuffle(valores, valores + s, rng);
     
     // Reinsertar valores permutados
+    idx = inicio;
     for (int k = 0; k < s; k++) {
-        solucion[indices[k]] = valores[k];
+        solucion[idx] = valores[k];
+        if (++idx == n) idx = 0;
     }
 }
+
+void mutarSublista(vector<int>& solucion, int s, EspacioTrabajo& ws) {
+    mutarSublista(solucion.data(), solucion.size(), s, ws);
+}
+
+void mutarSublista(vector<int>& solucion, int s) {
+    mutarSublista(solucion, s, espacioHilo());
+}
@@ -0,0 +1,146 @@
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include <fstream>
+
+// Dependencias (Unity Build): Core, Diversity (MatrizFrecuencias) y GeneticAlgorithm.cpp
+// (seleccionTorneo, mutarSwap, cruceOX, PoblacionSoA, evaluarHijo) incluidos antes en el main.
+
+using namespace std;
+
+// --- Configuración AGE (Genético Estacionario) ---
+struct ConfigAGE {
+    int poblacionSize = 50;
+    double probCruce = 1.0;      // En el estacionario siempre se cruza la pareja
+    double probMutacion = 0.05;  // Por hijo, como en el AGG
+    OperadorCruce cruce = CRUCE_OX; // OX, PMX, CX o Posicion (Crossover.cpp)
+    int maxEvaluaciones = 50000; // Parada por evaluaciones (mismo criterio que CHC)
+};
+
+struct ResultadoAGE {
+    vector<int> mejorSolucion;
+    long long mejorCoste;
+};
+
+// Montículo de máximos por fitness sobre slots: el peor individuo está siempre en la raíz.
+// Sustituir al peor es cambiar la raíz y hundirla, O(log N), sin reordenar la población.
+void hundirRaiz(vector<int>& monticulo, const vector<long long>& fitness) {
+    int N = monticulo.size();
+    int i = 0;
+    int slot = monticulo[0];
+    while (true) {
+        int hijo = 2 * i + 1;
+        if (hijo >= N) break;
+        if (hijo + 1 < N && fitness[monticulo[hijo + 1]] > fitness[monticulo[hijo]]) hijo++;
+        if (fitness[monticulo[hijo]] <= fitness[slot]) break;
+        monticulo[i] = monticulo[hijo];
+        i = hijo;
+    }
+    monticulo[i] = slot;
+}
+
+// Genético Estacionario (AGE)
+// En cada paso se seleccionan dos padres por torneo, se generan dos hijos y estos compiten
+// con los dos peores: cada hijo sustituye a la raíz del montículo si la mejora. Hacerlo con un
+// hijo y luego con el otro deja exactamente los N mejores de los N+2.
+// Los hijos nacen en dos slots de reserva del pool SoA; al entrar, su slot pasa al montículo
+// y el del desplazado queda de reserva (se intercambian índices, no genotipos).
+ResultadoAGE geneticoEstacionario(const vector<vector<int>>& flujo, const vector<vector<int>>& distancia, ConfigAGE config, string logFile = "") {
+    int n = flujo.size();
+    int N = config.poblacionSize;
+    ofstream log;
+
+    if (logFile != "") {
+        log.open(logFile);
+        log << "Eval,MejorFit,MediaFit,Diversidad\n";
+    }
+
+    // 1. Inicialización: N slots vivos + 2 de reserva para los hijos
+    PoblacionSoA pool;
+    pool.inicializar(N + 2, n);
+    vector<int> monticulo(N);
+    long long sumaFit = 0;
+    for(int i=0; i<N; i++) {
+        vector<int> sol = generarSolucionAleatoria(n);
+        pool.copiarGenotipo(i, sol.data());
+        pool.fitness[i] = evaluarSolucion(pool.genotipo(i), n, flujo, distancia);
+        sumaFit += pool.fitness[i];
+        monticulo[i] = i;
+    }
+    make_heap(monticulo.begin(), monticulo.end(), [&](int a, int b) { return pool.fitness[a] < pool.fitness[b]; });
+    int reserva[2] = {N, N + 1};
+
+    int mejorSlot = *min_element(monticulo.begin(), monticulo.end(), [&](int a, int b) { return pool.fitness[a] < pool.fitness[b]; });
+    vector<int> mejorGlobal(pool.genotipo(mejorSlot), pool.genotipo(mejorSlot) + n);
+    long long mejorGlobalFit = pool.fitness[mejorSlot];
+
+    MatrizFrecuencias frecuencias;
+    frecuencias.inicializar(n);
+    for(int i=0; i<N; i++) frecuencias.insertar(pool.genotipo(i));
+
+    EspacioTrabajo ws;
+    ws.reservar(n);
+    int kTorneo = max(2, (int)(N * 0.1)); // K = 10% Poblacion, como en el AGG
+    int evalCounter = N; // Contamos las iniciales
+    int siguienteLog = 0;
+
+    while (evalCounter < config.maxEvaluaciones) {
+        // Los hijos idénticos a un padre no gastan evaluación: sin diversidad ni mutación
+        // ya no puede aparecer nada nuevo y el presupuesto no avanzaría
+        if (config.probMutacion <= 0 && frecuencias.diversidad() == 0) break;
+        
+        // Log cada N evaluaciones (una "generación" equivalente)
+        if (logFile != "" && evalCounter >= siguienteLog) {
+            log << evalCounter << "," << mejorGlobalFit << "," << (double)sumaFit / N << "," << frecuencias.diversidad() << "\n";
+            siguienteLog = evalCounter + N;
+        }
+
+        // Selección (Padres): el montículo contiene todos los slots vivos
+        int p1Slot = seleccionTorneo(monticulo, pool.fitness, kTorneo);
+        int p2Slot = seleccionTorneo(monticulo, pool.fitness, kTorneo);
+        const int* p1 = pool.genotipo(p1Slot);
+        const int* p2 = pool.genotipo(p2Slot);
+        int* h1 = pool.genotipo(reserva[0]);
+        int* h2 = pool.genotipo(reserva[1]);
+
+        // Cruce
+        if (aleatorioUniforme() < config.probCruce) {
+            cruzar(config.cruce, p1, p2, h1, h2, n, ws);
+        } else {
+            pool.copiarGenotipo(reserva[0], p1);
+            pool.copiarGenotipo(reserva[1], p2);
+        }
+
+        // Mutación (Swap)
+        if (aleatorioUniforme() < config.probMutacion) mutarSwap(h1, n);
+        if (aleatorioUniforme() < config.probMutacion) mutarSwap(h2, n);
+
+        // Evaluar (delta respecto al padre más parecido; solo cuentan las evaluaciones hechas)
+        long long fit1 = pool.fitness[p1Slot];
+        long long fit2 = pool.fitness[p2Slot];
+        pool.fitness[reserva[0]] = evaluarHijo(h1, p1, fit1, p2, fit2, n, flujo, distancia, ws.enteros2.data(), &evalCounter);
+        pool.fitness[reserva[1]] = evaluarHijo(h2, p2, fit2, p1, fit1, n, flujo, distancia, ws.enteros2.data(), &evalCounter);
+
+        // Reemplazo de los peores: primero el mejor hijo, así el segundo compite con lo que quede
+        if (pool.fitness[reserva[1]] < pool.fitness[reserva[0]]) swap(reserva[0], reserva[1]);
+        for(int r=0; r<2; r++) {
+            int hijo = reserva[r];
+            int peor = monticulo[0];
+            if (pool.fitness[hijo] >= pool.fitness[peor]) break; // El otro hijo es peor aún
+
+            frecuencias.reemplazar(pool.genotipo(peor), pool.genotipo(hijo));
+            sumaFit += pool.fitness[hijo] - pool.fitness[peor];
+            monticulo[0] = hijo;
+            reserva[r] = peor;
+            hundirRaiz(monticulo, pool.fitness);
+
+            if (pool.fitness[hijo] < mejorGlobalFit) {
+                mejorGlobalFit = pool.fitness[hijo];
+                mejorGlobal.assign(pool.genotipo(hijo), pool.genotipo(hijo) + n);
+            }
+        }
+    }
+
+    if (logFile != "") log.close();
+    return {mejorGlobal, mejorGlobalFit};
+}
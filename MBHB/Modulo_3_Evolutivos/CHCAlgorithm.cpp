@@ -2,6 +2,8 @@
 #include <iostream>
 #include <algorithm>
 #include <fstream>
+#include <memory>
+#include <cstring>
 
 // Dependencias de otros módulos (Unity Build friendly)
 // Asumimos que Generador, Evaluador, Diversity y Mutation ya están incluidos o se incluirán en el main.
@@ -10,28 +12,22 @@
 // Para claridad, declaro lo que uso externamente.
 
 // External Functions needed:
-// int distanciaHamming(const vector<int>& a, const vector<int>& b);
-// void mutarSublista(vector<int>& sol, int s);
-// void cruceOX(const vector<int>& p1, const vector<int>& p2, vector<int>& h1, vector<int>& h2);
+// bool superaDistanciaHamming(const int* a, const int* b, int n, int umbral);
+// void mutarSublista(int* sol, int n, int s, EspacioTrabajo& ws);
+// void cruzar(OperadorCruce op, const int* p1, const int* p2, int* h1, int* h2, int n, EspacioTrabajo& ws);
+// struct PoblacionSoA, ordenarPorFitness(...), hashGenotipo(...), evaluarHijo(...) (Poblacion.cpp)
+// class PoolHilos (Core/Paralelo.cpp)
 // vector<int> generarSolucionAleatoria(int n);
 // long long evaluarSolucion(...);
 // inicializarSemilla(...);
 
 using namespace std;
 
-// Estructura Individuo (Local para evitar colisiones si no hay header común)
-struct IndividuoCHC {
-    vector<int> genotipo;
-    long long fitness;
-    
-    bool operator<(const IndividuoCHC& otro) const {
-        return fitness < otro.fitness;
-    }
-};
-
 struct ConfigCHC {
     int poblacionSize = 50; 
     int maxEvaluaciones = 50000; // Parada por evaluaciones (estándar en CHC para comparar esfuerzo)
+    OperadorCruce cruce = CRUCE_OX; // OX, PMX, CX o Posicion (Crossover.cpp)
+    int numHilos = 0; // Hilos para el emparejamiento (0 = todos los núcleos). El resultado no depende de este valor.
 };
 
 struct ResultadoCHC {
@@ -39,132 +35,297 @@ struct ResultadoCHC {
     long long mejorCoste;
 };
 
+// ¿Está ya el genotipo del slot 'hijo' entre los supervivientes seleccionados?
+// Un duplicado tiene el mismo fitness, y en la mezcla los iguales en fitness quedan contiguos:
+// basta recorrer hacia atrás la racha final de 'seleccionados' con ese fitness comparando hashes.
+bool esDuplicado(int hijo, const int* seleccionados, int numSeleccionados, const PoblacionSoA& pool, const vector<uint64_t>& hashSlot) {
+    long long fit = pool.fitness[hijo];
+    for(int k = numSeleccionados - 1; k >= 0 && pool.fitness[seleccionados[k]] == fit; k--) {
+        int otro = seleccionados[k];
+        if (hashSlot[otro] == hashSlot[hijo] &&
+            memcmp(pool.genotipo(otro), pool.genotipo(hijo), sizeof(int) * pool.n) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
 // Función de Cataclismo (Diverge)
 // Mantiene al mejor (elite), y rellena resto con copias mutadas al 35%
-void cataclismo(vector<IndividuoCHC>& poblacion, int n) {
-    // Asumimos poblacion ordenada, index 0 es el mejor
-    IndividuoCHC mejor = poblacion[0];
+// 'orden' son los slots vivos; orden[0] es el mejor
+void cataclismo(PoblacionSoA& pool, const vector<int>& orden, int n, EspacioTrabajo& ws) {
+    const int* mejor = pool.genotipo(orden[0]);
     
     // Tamaño de mutación fuerte (35%)
     int s = max(2, (int)(n * 0.35));
     
-    for (size_t i = 1; i < poblacion.size(); i++) {
-        poblacion[i] = mejor; // Copiar mejor
-        mutarSublista(poblacion[i].genotipo, s); // Mutar fuertemente
-        // Nota: El fitness queda invalidado, hay que reevaluar? 
-        // Sí, pero el Evaluador requeriría pasar Flujo/Distancia. 
-        // Lo haremos en el bucle principal o pasamos referencias aquí.
-        // Por diseño, marcaremos fitness como -1 y reevaluaremos fuera.
-        poblacion[i].fitness = -1; 
+    for (size_t i = 1; i < orden.size(); i++) {
+        pool.copiarGenotipo(orden[i], mejor); // Copiar mejor
+        mutarSublista(pool.genotipo(orden[i]), n, s, ws); // Mutar fuertemente
+        // El fitness queda invalidado: se reevalúa en el bucle principal (allí están Flujo/Distancia)
+        pool.fitness[orden[i]] = -1; 
     }
 }
 
-// Comparador para ordenar punteros o referencias si fuera necesario
-// Aquí ordenamos vector de objetos directamente.
-
-ResultadoCHC algoritmoCHC(const vector<vector<int>>& flujo, const vector<vector<int>>& distancia, ConfigCHC config, string logFile = "") {
-    int n = flujo.size();
+// Estado de un CHC que avanza generación a generación (ver EstadoAGG en GeneticAlgorithm.cpp)
+// No se puede copiar ni mover (PoolHilos): crearlo en su sitio.
+struct EstadoCHC {
+    const vector<vector<int>>* flujo = nullptr;
+    const vector<vector<int>>* distancia = nullptr;
+    ConfigCHC config;
+    int n = 0;
+    int N = 0;
     ofstream log;
-    if (logFile != "") {
-        log.open(logFile);
-        log << "Eval,MejorCoste,Umbral_d,EsCataclismo\n";
-    }
     
-    // 1. Inicialización
-    vector<IndividuoCHC> poblacion(config.poblacionSize);
-    for(int i=0; i<config.poblacionSize; i++) {
-        poblacion[i].genotipo = generarSolucionAleatoria(n);
-        poblacion[i].fitness = evaluarSolucion(poblacion[i].genotipo, flujo, distancia);
-    }
-    sort(poblacion.begin(), poblacion.end()); // Mejor en 0
+    // Pool SoA de 2N slots: N vivos (orden, ordenados por fitness) y N libres donde nacen los hijos.
+    // La supervivencia solo reordena índices de slot: los genotipos nunca se mueven.
+    PoblacionSoA pool;
+    vector<uint64_t> hashSlot; // Hash del genotipo de cada slot (rechazo de duplicados)
+    vector<int> orden, libres;
+    vector<int> mejorGlobal;
+    long long mejorGlobalFit = -1;
+    MatrizFrecuencias frecuencias; // Diversidad incremental de la población (Diversity.cpp)
     
-    IndividuoCHC mejorGlobal = poblacion[0];
+    int d = 0; // Umbral de incesto
+    int evalCounter = 0;
+    
+    // Buffers reutilizados entre generaciones (sin reservas de memoria en el bucle)
+    vector<int> indices, nuevoOrden, descartados, hijos;
+    
+    // Emparejamiento paralelo: la pareja p (posiciones indices[2p], indices[2p+1]) es una tarea que
+    // escribe sus hijos en los slots libres preasignados libres[2p], libres[2p+1], con su propio
+    // flujo aleatorio. El resultado para una semilla no depende del número de hilos.
+    unique_ptr<PoolHilos> hilos;
+    vector<EspacioTrabajo> ws;
+    int numPares = 0;
+    vector<unsigned int> semillas;
+    vector<char> cruzada;
+    vector<int> evalsPareja;
+    
+    void inicializar(const vector<vector<int>>& F, const vector<vector<int>>& D, const ConfigCHC& cfg, string logFile = "") {
+        flujo = &F;
+        distancia = &D;
+        config = cfg;
+        n = F.size();
+        N = config.poblacionSize;
+        if (logFile != "") {
+            log.open(logFile);
+            log << "Eval,MejorCoste,Umbral_d,EsCataclismo,Diversidad\n";
+        }
+        
+        // 1. Inicialización
+        pool.inicializar(2 * N, n);
+        hashSlot.assign(2 * N, 0);
+        orden.resize(N);
+        libres.resize(N);
+        for(int i=0; i<N; i++) {
+            vector<int> sol = generarSolucionAleatoria(n);
+            pool.copiarGenotipo(i, sol.data());
+            pool.fitness[i] = evaluarSolucion(pool.genotipo(i), n, F, D);
+            hashSlot[i] = hashGenotipo(pool.genotipo(i), n);
+            orden[i] = i;
+            libres[i] = N + i;
+        }
+        ordenarPorFitness(orden, pool.fitness); // Mejor en 0
+        
+        mejorGlobal.assign(pool.genotipo(orden[0]), pool.genotipo(orden[0]) + n);
+        mejorGlobalFit = pool.fitness[orden[0]];
+        
+        frecuencias.inicializar(n);
+        for(int slot : orden) frecuencias.insertar(pool.genotipo(slot));
+        
+        // Configuración Inicial CHC
+        d = n / 4; // Umbral de incesto inicial (L/4)
+        evalCounter = N; // Contamos las iniciales
+        
+        indices.resize(N);
+        nuevoOrden.resize(N);
+        descartados.resize(N);
+        hijos.resize(N);
+        
+        hilos.reset(new PoolHilos(config.numHilos));
+        ws.assign(hilos->numHilos(), EspacioTrabajo());
+        for(auto& w : ws) w.reservar(n);
+        numPares = N / 2;
+        semillas.assign(numPares, 0);
+        cruzada.assign(numPares, 0);
+        evalsPareja.assign(numPares, 0);
+    }
     
-    // Configuración Inicial CHC
-    int d = n / 4; // Umbral de incesto inicial (L/4)
-    int evalCounter = config.poblacionSize; // Contamos las iniciales
+    bool terminado() const { return evalCounter >= config.maxEvaluaciones; }
     
-    while (evalCounter < config.maxEvaluaciones) {
+    void cruzarPareja(int p, int hilo) {
+        rng.seed(semillas[p]);
+        EspacioTrabajo& w = ws[hilo];
+        int s1 = orden[indices[2*p]];
+        int s2 = orden[indices[2*p + 1]];
+        const int* p1 = pool.genotipo(s1);
+        const int* p2 = pool.genotipo(s2);
+        evalsPareja[p] = 0;
+        
+        // Check Incesto (acotado: solo interesa si la distancia supera d)
+        cruzada[p] = superaDistanciaHamming(p1, p2, n, d);
+        if (!cruzada[p]) return;
+        
+        // Los hijos nacen directamente en slots libres
+        int h1 = libres[2*p];
+        int h2 = libres[2*p + 1];
+        // Cruce (OX por defecto)
+        cruzar(config.cruce, p1, p2, pool.genotipo(h1), pool.genotipo(h2), n, w);
         
+        // Evaluar (Sin mutación): por delta si el hijo apenas difiere de un padre.
+        // Solo cuentan para el presupuesto las evaluaciones realmente hechas.
+        long long fit1 = pool.fitness[s1];
+        long long fit2 = pool.fitness[s2];
+        pool.fitness[h1] = evaluarHijo(pool.genotipo(h1), p1, fit1, p2, fit2, n, *flujo, *distancia, w.enteros2.data(), &evalsPareja[p]);
+        pool.fitness[h2] = evaluarHijo(pool.genotipo(h2), p2, fit2, p1, fit1, n, *flujo, *distancia, w.enteros2.data(), &evalsPareja[p]);
+        hashSlot[h1] = hashGenotipo(pool.genotipo(h1), n);
+        hashSlot[h2] = hashGenotipo(pool.genotipo(h2), n);
+    }
+    
+    // Una generación: emparejamiento, supervivencia y, si toca, cataclismo
+    void paso() {
         // --- 1. Selección y Cruce (Incesto) ---
-        vector<IndividuoCHC> hijos;
-        hijos.reserve(config.poblacionSize);
+        int numHijos = 0;
         
-        // Barajar población para emparejamiento aleatorio
-        // Copiamos índices para no perder el orden de la población principal (necesario para elitismo luego?)
-        // No, en CHC seleccionamos de (P + Hijos), así que el orden de P no importa tanto al generar hijos,
-        // pero sí necesitamos P intacta para la union.
-        vector<int> indices(config.poblacionSize);
-        for(int i=0; i<config.poblacionSize; i++) indices[i] = i;
+        // Barajar población para emparejamiento aleatorio (sobre posiciones de 'orden')
+        for(int i=0; i<N; i++) indices[i] = i;
         shuffle(indices.begin(), indices.end(), rng);
         
-        for(int i = 0; i < config.poblacionSize; i += 2) {
-            if (i+1 >= config.poblacionSize) break;
-            
-            IndividuoCHC& p1 = poblacion[indices[i]];
-            IndividuoCHC& p2 = poblacion[indices[i+1]];
-            
-            // Check Incesto
-            if (distanciaHamming(p1.genotipo, p2.genotipo) > d) {
-                IndividuoCHC h1, h2;
-                // Cruce OX
-                cruceOX(p1.genotipo, p2.genotipo, h1.genotipo, h2.genotipo);
-                
-                // Evaluar (Sin mutación)
-                h1.fitness = evaluarSolucion(h1.genotipo, flujo, distancia);
-                h2.fitness = evaluarSolucion(h2.genotipo, flujo, distancia);
-                evalCounter += 2;
-                
-                hijos.push_back(h1);
-                hijos.push_back(h2);
+        for(int p=0; p<numPares; p++) semillas[p] = rng();
+        auto tarea = [this](int p, int hilo) { cruzarPareja(p, hilo); };
+        hilos->paraCada(numPares, tarea);
+        
+        // Compactar en orden de pareja: libres = [hijos..., slots sin usar...]
+        int numSinUsar = 0;
+        for(int p=0; p<numPares; p++) {
+            evalCounter += evalsPareja[p];
+            if (cruzada[p]) {
+                hijos[numHijos++] = libres[2*p];
+                hijos[numHijos++] = libres[2*p + 1];
+            } else {
+                descartados[numSinUsar++] = libres[2*p];
+                descartados[numSinUsar++] = libres[2*p + 1];
             }
         }
+        if (N % 2 == 1) descartados[numSinUsar++] = libres[N - 1];
+        for(int i=0; i<numHijos; i++) libres[i] = hijos[i];
+        for(int i=0; i<numSinUsar; i++) libres[numHijos + i] = descartados[i];
         
         // --- 2. Control del Umbral y Supervivencia ---
-        if (hijos.empty()) {
+        if (numHijos == 0) {
             d--; // Reducir umbral si nadie se cruza
         } else {
-            // Elitismo: Unir P + Hijos y elegir N mejores
-            // Estrategia eficiente: Sort hijos, merge? O simplemente meter todo en un vector y sort.
-            vector<IndividuoCHC> pool = poblacion;
-            pool.insert(pool.end(), hijos.begin(), hijos.end());
-            
-            sort(pool.begin(), pool.end()); // Ordena por fitness ascendente
+            // Elitismo: de P + Hijos sobreviven los N mejores.
+            // Los padres ya están ordenados (orden): solo se ordenan los hijos y se mezclan
+            // ambas listas hasta tener N, en O(N + h log h) y sin mover genotipos.
+            // En empate de fitness pasa antes el padre; un hijo duplicado de un superviviente se rechaza.
+            ordenarPorFitness(libres.begin(), libres.begin() + numHijos, pool.fitness);
             
-            // Sobrescribir población con los N mejores
-            for(int i=0; i<config.poblacionSize; i++) {
-                poblacion[i] = pool[i];
+            int ip = 0, ih = 0, numSel = 0, numDesc = 0, aceptados = 0;
+            while (numSel < N) {
+                bool tomaPadre = (ih == numHijos) || (ip < N && pool.fitness[orden[ip]] <= pool.fitness[libres[ih]]);
+                if (tomaPadre) {
+                    nuevoOrden[numSel++] = orden[ip++];
+                } else {
+                    int hijo = libres[ih++];
+                    if (esDuplicado(hijo, nuevoOrden.data(), numSel, pool, hashSlot)) {
+                        descartados[numDesc++] = hijo;
+                    } else {
+                        nuevoOrden[numSel++] = hijo;
+                        aceptados++;
+                        frecuencias.insertar(pool.genotipo(hijo));
+                    }
+                }
             }
+            // Padres desplazados e hijos que no entran: sus slots quedan libres
+            for(; ip < N; ip++) {
+                frecuencias.eliminar(pool.genotipo(orden[ip]));
+                descartados[numDesc++] = orden[ip];
+            }
+            for(; ih < numHijos; ih++) descartados[numDesc++] = libres[ih];
+            
+            // numDesc == numHijos: ocupan el hueco de los hijos; libres[numHijos..N) no se usaron
+            for(int i=0; i<numDesc; i++) libres[i] = descartados[i];
+            orden.swap(nuevoOrden);
+            
+            // Sin duplicados la población no se llena de copias: si ningún hijo entra,
+            // la población no ha cambiado y también se reduce el umbral (regla clásica de CHC)
+            if (aceptados == 0) d--;
             
             // Actualizar Global
-            if (poblacion[0].fitness < mejorGlobal.fitness) {
-                mejorGlobal = poblacion[0];
+            if (pool.fitness[orden[0]] < mejorGlobalFit) {
+                mejorGlobalFit = pool.fitness[orden[0]];
+                mejorGlobal.assign(pool.genotipo(orden[0]), pool.genotipo(orden[0]) + n);
             }
         }
         
         // Logging
-        if (logFile != "") {
+        if (log.is_open()) {
             // Marcamos cataclismo en el log next step si d < 0
             bool cataclismoNext = (d < 0);
-            log << evalCounter << "," << mejorGlobal.fitness << "," << d << "," << (cataclismoNext ? 1 : 0) << "\n";
+            log << evalCounter << "," << mejorGlobalFit << "," << d << "," << (cataclismoNext ? 1 : 0) << "," << frecuencias.diversidad() << "\n";
         }
         
         // --- 3. Cataclismo ---
         if (d < 0) {
             // Diverge: La población ha convergido. Reiniciar manteniendo el mejor.
-            cataclismo(poblacion, n); // Muta todos menos el mejor
+            cataclismo(pool, orden, n, ws[0]); // Muta todos menos el mejor
+            
+            // La población cambia casi entera: reconstruir la matriz es O(p*n)
+            frecuencias.inicializar(n);
+            for(int slot : orden) frecuencias.insertar(pool.genotipo(slot));
             
-            // Reevaluar los mutados
-            for(size_t i=1; i<poblacion.size(); i++) {
-                poblacion[i].fitness = evaluarSolucion(poblacion[i].genotipo, flujo, distancia);
-                evalCounter++;
+            // Reevaluar los mutados (son el mejor + una sublista barajada: delta si compensa)
+            const int* mejor = pool.genotipo(orden[0]);
+            long long fitMejor = pool.fitness[orden[0]];
+            for(int i=1; i<N; i++) {
+                pool.fitness[orden[i]] = evaluarHijo(pool.genotipo(orden[i]), mejor, fitMejor, mejor, fitMejor, n, *flujo, *distancia, ws[0].enteros2.data(), &evalCounter);
+                hashSlot[orden[i]] = hashGenotipo(pool.genotipo(orden[i]), n);
             }
+            // La mezcla de supervivientes necesita a los padres ordenados
+            ordenarPorFitness(orden, pool.fitness);
             
             // Resetear umbral
             d = n / 4;
         }
     }
     
-    if (logFile != "") log.close();
-    return {mejorGlobal.genotipo, mejorGlobal.fitness};
+    // Cierre (el mejor global ya está al día tras cada paso)
+    void finalizar() {
+        if (log.is_open()) log.close();
+    }
+    
+    // Migración: un inmigrante sustituye al peor si lo mejora y no está ya en la población
+    bool recibirInmigrante(const int* genotipo, long long fit) {
+        int peor = orden.back();
+        if (fit >= pool.fitness[peor]) return false;
+        uint64_t h = hashGenotipo(genotipo, n);
+        for(int slot : orden) {
+            if (hashSlot[slot] == h && memcmp(pool.genotipo(slot), genotipo, sizeof(int) * n) == 0) return false;
+        }
+        frecuencias.reemplazar(pool.genotipo(peor), genotipo);
+        pool.copiarGenotipo(peor, genotipo);
+        pool.fitness[peor] = fit;
+        hashSlot[peor] = h;
+        recolocarUltimo(orden, pool.fitness);
+        if (fit < mejorGlobalFit) {
+            mejorGlobalFit = fit;
+            mejorGlobal.assign(genotipo, genotipo + n);
+        }
+        return true;
+    }
+    
+    // Emigrantes: los 'i'-ésimos mejores de la población viva
+    const int* individuo(int i) const { return pool.genotipo(orden[i]); }
+    long long fitnessIndividuo(int i) const { return pool.fitness[orden[i]]; }
+};
+
+ResultadoCHC algoritmoCHC(const vector<vector<int>>& flujo, const vector<vector<int>>& distancia, ConfigCHC config, string logFile = "") {
+    EstadoCHC estado;
+    estado.inicializar(flujo, distancia, config, logFile);
+    
+    while (!estado.terminado()) estado.paso();
+    estado.finalizar();
+    return {estado.mejorGlobal, estado.mejorGlobalFit};
 }
@@ -1,58 +1,202 @@
 #include <vector>
 #include <algorithm>
-#include <vector>
 #include <iostream>
+#include <cstring>
+// Asumimos Core/Generador.cpp y Core/EspacioTrabajo.cpp incluidos en main
 
 using namespace std;
 
+// Todos los cruces escriben en buffers del llamador (n posiciones) y usan el espacio de trabajo
+// (marcadores por épocas, inversas de los padres) en lugar de reservar memoria: O(n) por pareja.
+// Los rellenos son "sin saltos": se escribe siempre en el buffer y el índice avanza solo si el
+// valor no estaba usado, así el bucle no depende de una rama impredecible.
+
+// Copia en orden los valores de 'origen[desde..hasta)' no marcados en 'usados' a partir de buf[k]
+// Devuelve el nuevo k. 'buf' necesita una posición de holgura tras el último valor válido.
+int acumularNoUsados(const int* origen, int desde, int hasta, const MarcadorEpoca& usados, int* buf, int k) {
+    for (int i = desde; i < hasta; i++) {
+        int v = origen[i];
+        buf[k] = v;
+        k += !usados.marcado(v);
+    }
+    return k;
+}
+
 // Operador de Cruce: Order Crossover (OX)
 // Preserva una sub-secuencia del Padre 1 y rellena con el orden relativo del Padre 2.
-void cruceOX(const vector<int>& padre1, const vector<int>& padre2, vector<int>& hijo1, vector<int>& hijo2) {
-    int n = padre1.size();
-    hijo1.assign(n, -1);
-    hijo2.assign(n, -1);
+// El recorrido circular desde cut2+1 se hace en dos tramos lineales (sin aritmética modular):
+// se leen P2[cut2+1..n) y P2[0..cut2], y lo acumulado se vuelca en [cut2+1, n) y [0, cut1).
+void rellenarOX(const int* relleno, int* hijo, int n, int cut1, int cut2, const MarcadorEpoca& usados, int* buf) {
+    int k = acumularNoUsados(relleno, cut2 + 1, n, usados, buf, 0);
+    acumularNoUsados(relleno, 0, cut2 + 1, usados, buf, k);
+    int cola = n - 1 - cut2;
+    memcpy(hijo + cut2 + 1, buf, sizeof(int) * cola);
+    memcpy(hijo, buf + cola, sizeof(int) * cut1);
+}
+
+void cruceOX(const int* padre1, const int* padre2, int* hijo1, int* hijo2, int n, EspacioTrabajo& ws) {
+    ws.reservar(n);
     
     // 1. Seleccionar dos puntos de corte aleatorios
     int cut1 = aleatorio(0, n - 2);
     int cut2 = aleatorio(cut1 + 1, n - 1);
+    int largo = cut2 - cut1 + 1;
     
-    // --- Hijo 1 ---
-    // Copiar segmento de P1
-    vector<bool> enHijo1(n, false);
-    for (int i = cut1; i <= cut2; i++) {
-        hijo1[i] = padre1[i];
-        enHijo1[padre1[i]] = true;
-    }
-    
-    // Rellenar resto con P2 (empezando desde cut2 + 1, circularmente)
-    int currentP2 = (cut2 + 1) % n;
-    int currentH1 = (cut2 + 1) % n;
-    
-    while (currentH1 != cut1) {
-        int valorP2 = padre2[currentP2];
-        if (!enHijo1[valorP2]) {
-            hijo1[currentH1] = valorP2;
-            currentH1 = (currentH1 + 1) % n;
-        }
-        currentP2 = (currentP2 + 1) % n;
-    }
+    // --- Hijo 1 --- Copiar segmento de P1 y rellenar con P2
+    MarcadorEpoca& enHijo1 = ws.marcas;
+    enHijo1.nuevaEpoca();
+    memcpy(hijo1 + cut1, padre1 + cut1, sizeof(int) * largo);
+    for (int i = cut1; i <= cut2; i++) enHijo1.marcar(padre1[i]);
+    rellenarOX(padre2, hijo1, n, cut1, cut2, enHijo1, ws.enteros.data());
     
     // --- Hijo 2 (Simétrico: P2 base, P1 relleno) ---
-    vector<bool> enHijo2(n, false);
+    MarcadorEpoca& enHijo2 = ws.marcas2;
+    enHijo2.nuevaEpoca();
+    memcpy(hijo2 + cut1, padre2 + cut1, sizeof(int) * largo);
+    for (int i = cut1; i <= cut2; i++) enHijo2.marcar(padre2[i]);
+    rellenarOX(padre1, hijo2, n, cut1, cut2, enHijo2, ws.enteros.data());
+}
+
+// Operador de Cruce: Partially Mapped Crossover (PMX)
+// El hijo 1 hereda el segmento de P1 y el resto de P2; los valores de P2[cut1..cut2] que
+// quedan fuera se recolocan siguiendo la correspondencia P1 <-> P2 del segmento.
+// Cadena lineal: desde una posición i del segmento, j = posP2[P1[j]] hasta salir del segmento.
+// Esa función es inyectiva y cada cadena empieza en una posición sin predecesor, así que las
+// cadenas son disjuntas: en total O(n), no O(n * largo) como el PMX de manual.
+void hijoPMX(const int* base, const int* relleno, const int* posBase, const int* posRelleno, int* hijo,
+             int n, int cut1, int cut2, MarcadorEpoca& ocupada) {
+    ocupada.nuevaEpoca();
+    for (int i = cut1; i <= cut2; i++) {
+        hijo[i] = base[i];
+        ocupada.marcar(i);
+    }
+    // Pertenencia al segmento con una sola comparación sin signo
+    unsigned int largo = cut2 - cut1;
     for (int i = cut1; i <= cut2; i++) {
-        hijo2[i] = padre2[i];
-        enHijo2[padre2[i]] = true;
+        int v = relleno[i];
+        if ((unsigned int)(posBase[v] - cut1) <= largo) continue; // Ya está en el segmento heredado
+        int j = i;
+        do { j = posRelleno[base[j]]; } while ((unsigned int)(j - cut1) <= largo);
+        hijo[j] = v;
+        ocupada.marcar(j);
     }
+    // Resto de posiciones: directamente del padre de relleno (selección sin salto)
+    for (int i = 0; i < n; i++) {
+        hijo[i] = ocupada.marcado(i) ? hijo[i] : relleno[i];
+    }
+}
+
+// Inversa de una permutación: pos[sol[i]] = i
+void inversaPermutacion(const int* sol, int* pos, int n) {
+    for (int i = 0; i < n; i++) pos[sol[i]] = i;
+}
+
+void crucePMX(const int* padre1, const int* padre2, int* hijo1, int* hijo2, int n, EspacioTrabajo& ws) {
+    ws.reservar(n);
+    int cut1 = aleatorio(0, n - 2);
+    int cut2 = aleatorio(cut1 + 1, n - 1);
+    
+    int* pos1 = ws.enteros.data();
+    int* pos2 = ws.enteros2.data();
+    inversaPermutacion(padre1, pos1, n);
+    inversaPermutacion(padre2, pos2, n);
     
-    int currentP1 = (cut2 + 1) % n;
-    int currentH2 = (cut2 + 1) % n;
+    hijoPMX(padre1, padre2, pos1, pos2, hijo1, n, cut1, cut2, ws.marcas);
+    hijoPMX(padre2, padre1, pos2, pos1, hijo2, n, cut1, cut2, ws.marcas2);
+}
+
+// Operador de Cruce: Cycle Crossover (CX)
+// Descompone las posiciones en ciclos (i -> posP1[P2[i]]) y los reparte alternando padres:
+// ciclos pares de P1 al hijo 1 (y de P2 al hijo 2), impares al revés. Cada valor conserva la
+// posición que tenía en uno de los padres. Determinista (no consume el generador), O(n).
+void cruceCX(const int* padre1, const int* padre2, int* hijo1, int* hijo2, int n, EspacioTrabajo& ws) {
+    ws.reservar(n);
+    int* pos1 = ws.enteros.data();
+    inversaPermutacion(padre1, pos1, n);
     
-    while (currentH2 != cut1) {
-        int valorP1 = padre1[currentP1];
-        if (!enHijo2[valorP1]) {
-            hijo2[currentH2] = valorP1;
-            currentH2 = (currentH2 + 1) % n;
-        }
-        currentP1 = (currentP1 + 1) % n;
+    MarcadorEpoca& visitada = ws.marcas;
+    visitada.nuevaEpoca();
+    int ciclo = 0;
+    for (int i = 0; i < n; i++) {
+        if (visitada.marcado(i)) continue;
+        // Selección sin ramas por posición: 'a' es el padre que da al hijo 1 en este ciclo
+        const int* a = (ciclo & 1) ? padre2 : padre1;
+        const int* b = (ciclo & 1) ? padre1 : padre2;
+        int j = i;
+        do {
+            visitada.marcar(j);
+            hijo1[j] = a[j];
+            hijo2[j] = b[j];
+            j = pos1[padre2[j]];
+        } while (j != i);
+        ciclo++;
+    }
+}
+
+// Operador de Cruce: Basado en Posición (Syswerda)
+// Cada posición se elige con probabilidad 1/2 (un bit aleatorio por posición, 32 por llamada
+// al generador). El hijo 1 toma P1 en las elegidas y rellena el resto con el orden de P2;
+// el hijo 2, al revés, con las mismas posiciones.
+// Los bits son aleatorios, así que una rama por posición fallaría la mitad de las veces: se
+// particionan las posiciones sin saltos (elegidas al principio de 'lista', el resto al final
+// en orden inverso) y después cada fase recorre su tramo sin condiciones.
+void hijoPosicion(const int* base, const int* relleno, int* hijo, int n, const int* lista, int numElegidas,
+                  MarcadorEpoca& usados, int* buf) {
+    usados.nuevaEpoca();
+    for (int t = 0; t < numElegidas; t++) {
+        int i = lista[t];
+        hijo[i] = base[i];
+        usados.marcar(base[i]);
+    }
+    acumularNoUsados(relleno, 0, n, usados, buf, 0);
+    for (int t = 0; t < n - numElegidas; t++) hijo[lista[n - 1 - t]] = buf[t];
+}
+
+void crucePosicion(const int* padre1, const int* padre2, int* hijo1, int* hijo2, int n, EspacioTrabajo& ws) {
+    ws.reservar(n);
+    int* lista = ws.enteros2.data();
+    int elegidas = 0, fin = n;
+    unsigned int bits = 0;
+    for (int i = 0; i < n; i++) {
+        if ((i & 31) == 0) bits = rng();
+        int b = bits & 1;
+        lista[b ? elegidas : fin - 1] = i;
+        elegidas += b;
+        fin -= 1 - b;
+        bits >>= 1;
     }
+    hijoPosicion(padre1, padre2, hijo1, n, lista, elegidas, ws.marcas, ws.enteros.data());
+    hijoPosicion(padre2, padre1, hijo2, n, lista, elegidas, ws.marcas2, ws.enteros.data());
+}
+
+// Selección del operador por configuración (AGG, AGE, CHC)
+enum OperadorCruce { CRUCE_OX, CRUCE_PMX, CRUCE_CX, CRUCE_POSICION };
+
+const char* nombreCruce(OperadorCruce op) {
+    switch (op) {
+        case CRUCE_PMX: return "PMX";
+        case CRUCE_CX: return "CX";
+        case CRUCE_POSICION: return "Posicion";
+        default: return "OX";
+    }
+}
+
+void cruzar(OperadorCruce op, const int* padre1, const int* padre2, int* hijo1, int* hijo2, int n, EspacioTrabajo& ws) {
+    switch (op) {
+        case CRUCE_PMX: crucePMX(padre1, padre2, hijo1, hijo2, n, ws); break;
+        case CRUCE_CX: cruceCX(padre1, padre2, hijo1, hijo2, n, ws); break;
+        case CRUCE_POSICION: crucePosicion(padre1, padre2, hijo1, hijo2, n, ws); break;
+        default: cruceOX(padre1, padre2, hijo1, hijo2, n, ws); break;
+    }
+}
+
+void cruceOX(const vector<int>& padre1, const vector<int>& padre2, vector<int>& hijo1, vector<int>& hijo2, EspacioTrabajo& ws) {
+    int n = padre1.size();
+    hijo1.resize(n); // Sin coste si el hijo ya tenía tamaño n
+    hijo2.resize(n);
+    cruceOX(padre1.data(), padre2.data(), hijo1.data(), hijo2.data(), n, ws);
+}
+
+void cruceOX(const vector<int>& padre1, const vector<int>& padre2, vector<int>& hijo1, vector<int>& hijo2) {
+    cruceOX(padre1, padre2, hijo1, hijo2, espacioHilo());
 }
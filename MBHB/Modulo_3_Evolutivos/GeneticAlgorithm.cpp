@@ -2,148 +2,358 @@
 #include <iostream>
 #include <algorithm>
 #include <fstream>
+#include <memory>
 #include "Crossover.cpp"
-// Asumimos Core (Evaluador, Generador) incluido en main o unity build
+#include "Poblacion.cpp"
+// Asumimos Core (Evaluador, Generador, EspacioTrabajo, Paralelo), Diversity (MatrizFrecuencias) y
+// LocalSearch (busquedaLocalAcotada, para el memético) incluidos en main o unity build
 
 using namespace std;
 
-struct Individuo {
-    vector<int> genotipo;
-    long long fitness;
-    
-    // Operador para ordenar (menor fitness es mejor en minimización)
-    bool operator<(const Individuo& otro) const {
-        return fitness < otro.fitness;
-    }
-};
-
 // --- Configuración AGG ---
 struct ConfigAGG {
     int poblacionSize = 50; // N=50
     double probCruce = 0.9; // 90%
     double probMutacion = 0.05; // 5% por individuo (o 1/N por gen? Guia dice Intercambio simple)
     int maxGeneraciones = 200; // Criterio parada
+    int maxEvaluaciones = 0; // Presupuesto de evaluaciones (hijos + BL); 0 = sin límite, solo maxGeneraciones
+    OperadorCruce cruce = CRUCE_OX; // OX, PMX, CX o Posicion (Crossover.cpp)
+    int numHilos = 0; // Hilos para generar/evaluar hijos (0 = todos los núcleos). El resultado no depende de este valor.
+    
+    // Memético (AGG + BL): cada 'periodoBL' generaciones, BL acotada sobre la fracción 'fraccionBL' mejor.
+    // periodoBL = 0 desactiva la BL (AGG puro).
+    int periodoBL = 0;
+    double fraccionBL = 0.1;
+    int maxDeltasBL = 0; // Tope de deltas por individuo (0 = matriz + n movimientos: n(n-1)/2 + n(2n-3))
 };
 
 // Selección por Torneo: k = 10% de N
-int seleccionTorneo(const vector<Individuo>& poblacion, int k) {
-    int n = poblacion.size();
-    int mejorIdx = -1;
+// 'orden' son los slots de la población ordenados por fitness; devuelve el slot ganador
+int seleccionTorneo(const vector<int>& orden, const vector<long long>& fitness, int k) {
+    int n = orden.size();
+    int mejorSlot = -1;
     long long mejorFit = -1;
     
     for(int i=0; i<k; i++) {
-        int idx = aleatorio(0, n-1);
-        if (mejorIdx == -1 || poblacion[idx].fitness < mejorFit) {
-            mejorIdx = idx;
-            mejorFit = poblacion[idx].fitness;
+        int slot = orden[aleatorio(0, n-1)];
+        if (mejorSlot == -1 || fitness[slot] < mejorFit) {
+            mejorSlot = slot;
+            mejorFit = fitness[slot];
         }
     }
-    return mejorIdx;
+    return mejorSlot;
 }
 
 // Mutación: Swap simple
-void mutarSwap(vector<int>& sol) {
-    int n = sol.size();
+void mutarSwap(int* sol, int n) {
     int i = aleatorio(0, n-1);
     int j = aleatorio(0, n-1);
     while (i == j) j = aleatorio(0, n-1);
     swap(sol[i], sol[j]);
 }
 
+void mutarSwap(vector<int>& sol) {
+    mutarSwap(sol.data(), sol.size());
+}
+
 struct ResultadoAGG {
     vector<int> mejorSolucion;
     long long mejorCoste;
+    int evaluaciones; // Iniciales + hijos + deltas de BL (nunca supera maxEvaluaciones)
     // Log vectors could be added here
 };
 
-ResultadoAGG geneticoGeneracional(const vector<vector<int>>& flujo, const vector<vector<int>>& distancia, ConfigAGG config, string logFile = "") {
-    int n = flujo.size();
+// Estado de un AGG que avanza generación a generación
+// geneticoGeneracional() lo ejecuta hasta el final; el modelo de islas (Islas.cpp) intercala
+// pasos con migraciones. No se puede copiar ni mover (PoolHilos): crearlo en su sitio.
+struct EstadoAGG {
+    const vector<vector<int>>* flujo = nullptr;
+    const vector<vector<int>>* distancia = nullptr;
+    ConfigAGG config;
+    int n = 0;
+    int gen = 0;
     ofstream log;
     
-    if (logFile != "") {
-        log.open(logFile);
-        log << "Gen,MejorFit,MediaFit\n";
+    // Doble buffer SoA: 'actual' es la generación viva y 'siguiente' se rellena en su sitio.
+    // Ambos tienen un slot extra (el N) para el segundo hijo descartado cuando N es impar.
+    PoblacionSoA actual, siguiente;
+    vector<int> orden; // Slots de 'actual' ordenados por fitness (mejor primero)
+    vector<int> mejorGlobal;
+    long long mejorGlobalFit = -1;
+    MatrizFrecuencias frecuencias; // Diversidad incremental (Hamming medio por pares en O(1) por consulta)
+    
+    // Generación paralela: cada pareja de padres es una tarea independiente que escribe sus dos
+    // hijos en slots fijos (1+2p, 2+2p) con su propio flujo aleatorio, sembrado desde 'rng' en orden.
+    // Así el resultado para una semilla es el mismo con cualquier número de hilos.
+    unique_ptr<PoolHilos> hilos;
+    vector<EspacioTrabajo> ws;
+    int numPares = 0; // ceil((N-1)/2): el slot N recoge el hijo sobrante
+    vector<unsigned int> semillas;
+    vector<int> evalsPareja;
+    int kTorneo = 2;
+    int evalCounter = 0; // Evaluaciones hechas (iniciales + hijos + deltas de BL)
+    int paresConVariacion = 0; // Parejas que cruzan/mutan en esta generación (menos en la última, para no pasarse)
+    bool agotado = false; // El presupuesto ya no da para una generación completa
+    
+    // Memético: matriz de deltas por hilo, deltas gastados por individuo y marca de óptimo local
+    // por slot (el élite copiado ya es óptimo local: repetir su BL gastaría la matriz entera para nada)
+    vector<MatrizDeltasSwap> matrices;
+    vector<int> deltasBL;
+    vector<char> optimoActual, optimoSiguiente;
+    vector<uint64_t> hashBL;
+    vector<int> duplicadoBL; // Índice del primer clon en la fase de BL (-1 si es el primero)
+    int numBL = 0;
+    int topeBL = 0; // Tope de deltas por individuo en la fase actual
+    
+    void inicializar(const vector<vector<int>>& F, const vector<vector<int>>& D, const ConfigAGG& cfg, string logFile = "") {
+        flujo = &F;
+        distancia = &D;
+        config = cfg;
+        n = F.size();
+        gen = 0;
+        agotado = false;
+        
+        if (logFile != "") {
+            log.open(logFile);
+            log << "Gen,MejorFit,MediaFit,Diversidad\n";
+        }
+        
+        // 1. Inicialización
+        actual.inicializar(config.poblacionSize + 1, n);
+        siguiente.inicializar(config.poblacionSize + 1, n);
+        
+        for(int i=0; i<config.poblacionSize; i++) {
+            vector<int> sol = generarSolucionAleatoria(n);
+            actual.copiarGenotipo(i, sol.data());
+            actual.fitness[i] = evaluarSolucion(actual.genotipo(i), n, F, D);
+        }
+        evalCounter = config.poblacionSize;
+        
+        // Ordenar inicial (opcional, ayuda a elitismo): se ordenan slots, no individuos
+        orden.resize(config.poblacionSize);
+        for(int i=0; i<config.poblacionSize; i++) orden[i] = i;
+        ordenarPorFitness(orden, actual.fitness); // Menor a Mayor
+        
+        mejorGlobal.assign(actual.genotipo(orden[0]), actual.genotipo(orden[0]) + n);
+        mejorGlobalFit = actual.fitness[orden[0]];
+        
+        frecuencias.inicializar(n);
+        for(int i=0; i<config.poblacionSize; i++) frecuencias.insertar(actual.genotipo(i));
+        
+        hilos.reset(new PoolHilos(config.numHilos));
+        ws.assign(hilos->numHilos(), EspacioTrabajo());
+        for(auto& w : ws) w.reservar(n);
+        numPares = config.poblacionSize / 2;
+        semillas.assign(numPares, 0);
+        evalsPareja.assign(numPares, 0);
+        kTorneo = max(2, (int)(config.poblacionSize * 0.1)); // K = 10% Poblacion
+        
+        if (config.periodoBL > 0) {
+            if (config.maxDeltasBL <= 0) config.maxDeltasBL = n * (n - 1) / 2 + n * (2 * n - 3);
+            numBL = min(config.poblacionSize, max(1, (int)(config.poblacionSize * config.fraccionBL + 0.5)));
+            matrices.assign(hilos->numHilos(), MatrizDeltasSwap());
+            deltasBL.assign(numBL, 0);
+            hashBL.assign(numBL, 0);
+            duplicadoBL.assign(numBL, -1);
+        }
+        optimoActual.assign(config.poblacionSize + 1, 0);
+        optimoSiguiente.assign(config.poblacionSize + 1, 0);
     }
     
-    // 1. Inicialización
-    vector<Individuo> poblacion(config.poblacionSize);
-    for(int i=0; i<config.poblacionSize; i++) {
-        poblacion[i].genotipo = generarSolucionAleatoria(n);
-        poblacion[i].fitness = evaluarSolucion(poblacion[i].genotipo, flujo, distancia);
+    bool terminado() const {
+        return agotado || gen >= config.maxGeneraciones || (config.maxEvaluaciones > 0 && evalCounter >= config.maxEvaluaciones);
     }
     
-    // Ordenar inicial (opcional, ayuda a elitismo)
-    sort(poblacion.begin(), poblacion.end()); // Menor a Mayor
-    Individuo mejorGlobal = poblacion[0];
+    // Un hijo idéntico a un padre que ya es óptimo local también lo es: no se le repite la BL
+    char heredaOptimo(const int* hijo, int p1Slot, int p2Slot) const {
+        if (optimoActual[p1Slot] && equal(hijo, hijo + n, actual.genotipo(p1Slot))) return 1;
+        if (optimoActual[p2Slot] && equal(hijo, hijo + n, actual.genotipo(p2Slot))) return 1;
+        return 0;
+    }
     
-    // Bucle Evolutivo
-    for(int gen = 0; gen < config.maxGeneraciones; gen++) {
+    void generarPareja(int p, int hilo) {
+        rng.seed(semillas[p]);
+        EspacioTrabajo& w = ws[hilo];
+        
+        // Selección (Padres)
+        int p1Slot = seleccionTorneo(orden, actual.fitness, kTorneo);
+        int p2Slot = seleccionTorneo(orden, actual.fitness, kTorneo);
+        
+        // Los hijos se construyen en su slot definitivo (el último puede ser el de descarte)
+        int h1Slot = 1 + 2 * p;
+        int h2Slot = 2 + 2 * p;
+        int* h1 = siguiente.genotipo(h1Slot);
+        int* h2 = siguiente.genotipo(h2Slot);
+        const int* p1 = actual.genotipo(p1Slot);
+        const int* p2 = actual.genotipo(p2Slot);
+        
+        // Cruce (0.9). Las parejas que ya no caben en el presupuesto pasan los padres tal cual (coste 0)
+        bool variacion = p < paresConVariacion;
+        if (variacion && aleatorioUniforme() < config.probCruce) {
+            cruzar(config.cruce, p1, p2, h1, h2, n, w);
+        } else {
+            siguiente.copiarGenotipo(h1Slot, p1);
+            siguiente.copiarGenotipo(h2Slot, p2);
+        }
+        
+        // Mutación (Swap)
+        if (variacion && aleatorioUniforme() < config.probMutacion) mutarSwap(h1, n);
+        if (variacion && aleatorioUniforme() < config.probMutacion) mutarSwap(h2, n);
+        
+        // Evaluar Hijos (delta respecto al padre más parecido cuando sale más barato)
+        evalsPareja[p] = 0;
+        siguiente.fitness[h1Slot] = evaluarHijo(h1, p1, actual.fitness[p1Slot], p2, actual.fitness[p2Slot], n, *flujo, *distancia, w.enteros2.data(), &evalsPareja[p]);
+        siguiente.fitness[h2Slot] = evaluarHijo(h2, p2, actual.fitness[p2Slot], p1, actual.fitness[p1Slot], n, *flujo, *distancia, w.enteros2.data(), &evalsPareja[p]);
+        optimoSiguiente[h1Slot] = heredaOptimo(h1, p1Slot, p2Slot);
+        optimoSiguiente[h2Slot] = heredaOptimo(h2, p1Slot, p2Slot);
+    }
+    
+    // BL acotada sobre el i-ésimo mejor (tarea independiente: solo toca su slot)
+    void mejorarIndividuo(int i, int hilo) {
+        int slot = orden[i];
+        deltasBL[i] = 0;
+        if (optimoActual[slot] || duplicadoBL[i] >= 0) return;
+        bool optimo = false;
+        deltasBL[i] = busquedaLocalAcotada(actual.genotipo(slot), n, actual.fitness[slot], *flujo, *distancia, topeBL, matrices[hilo], &optimo);
+        // Solo un óptimo local real queda marcado (no se insiste hasta que cambie); si lo cortó
+        // el tope, se le vuelve a ofrecer la BL en la siguiente fase
+        optimoActual[slot] = optimo;
+    }
+    
+    // Fase memética: BL sobre los numBL mejores en paralelo; los deltas cuentan en el presupuesto
+    void pasoBL() {
+        // Con presupuesto, la fase no puede pasarse de lo que queda
+        topeBL = config.maxDeltasBL;
+        if (config.maxEvaluaciones > 0) topeBL = min(topeBL, (config.maxEvaluaciones - evalCounter) / numBL);
+        
+        // Clones dentro de la fase (frecuentes en una población convergida): solo el primero hace la BL
+        for(int i=0; i<numBL; i++) {
+            const int* g = actual.genotipo(orden[i]);
+            hashBL[i] = hashGenotipo(g, n);
+            duplicadoBL[i] = -1;
+            for(int j=0; j<i && duplicadoBL[i] < 0; j++) {
+                if (duplicadoBL[j] < 0 && hashBL[j] == hashBL[i] && equal(g, g + n, actual.genotipo(orden[j]))) duplicadoBL[i] = j;
+            }
+        }
+        
+        auto tarea = [this](int i, int hilo) { mejorarIndividuo(i, hilo); };
+        hilos->paraCada(numBL, tarea);
+        for(int i=0; i<numBL; i++) evalCounter += deltasBL[i];
+        
+        // Los clones reciben el resultado de su original sin gastar nada
+        for(int i=0; i<numBL; i++) {
+            if (duplicadoBL[i] < 0) continue;
+            int slot = orden[i], original = orden[duplicadoBL[i]];
+            actual.copiarGenotipo(slot, actual.genotipo(original));
+            actual.fitness[slot] = actual.fitness[original];
+            optimoActual[slot] = optimoActual[original];
+        }
+        
+        // La BL cambia genotipos en su sitio: reconstruir la matriz es O(p*n), despreciable frente a la BL
+        frecuencias.inicializar(n);
+        for(int i=0; i<config.poblacionSize; i++) frecuencias.insertar(actual.genotipo(i));
+        ordenarPorFitness(orden, actual.fitness);
+        
+        if (actual.fitness[orden[0]] < mejorGlobalFit) {
+            mejorGlobalFit = actual.fitness[orden[0]];
+            mejorGlobal.assign(actual.genotipo(orden[0]), actual.genotipo(orden[0]) + n);
+        }
+    }
+    
+    // Una generación completa
+    void paso() {
+        int mejorSlot = orden[0];
         
         // Log Statistics
         long long sumaFit = 0;
-        for(const auto& ind : poblacion) sumaFit += ind.fitness;
+        for(int i=0; i<config.poblacionSize; i++) sumaFit += actual.fitness[i];
         double mediaFit = (double)sumaFit / config.poblacionSize;
         
-        if (logFile != "") {
-            log << gen << "," << poblacion[0].fitness << "," << mediaFit << "\n";
+        if (log.is_open()) {
+            log << gen << "," << actual.fitness[mejorSlot] << "," << mediaFit << "," << frecuencias.diversidad() << "\n";
         }
         
-        if (poblacion[0].fitness < mejorGlobal.fitness) {
-            mejorGlobal = poblacion[0];
+        if (actual.fitness[mejorSlot] < mejorGlobalFit) {
+            mejorGlobalFit = actual.fitness[mejorSlot];
+            mejorGlobal.assign(actual.genotipo(mejorSlot), actual.genotipo(mejorSlot) + n);
         }
         
-        // Nueva Población
-        vector<Individuo> nuevaPoblacion;
-        nuevaPoblacion.reserve(config.poblacionSize);
-        
-        // 2. Elitismo: Pasar el mejor de la anterior (el 0 tras ordenar)
+        // Nueva Población (se escribe directamente en los slots de 'siguiente')
+        // 2. Elitismo: Pasar el mejor de la anterior (orden[0]) al slot 0
         // La guía sugiere pasar "el mejor o los mejores". Pasamos 1 seguro.
-        // Ojo: Si la población no está ordenada, hay que buscar el mejor. 
-        // Como ordenaremos al final del bucle, poblacion[0] es el mejor de la generación actual.
-        nuevaPoblacion.push_back(poblacion[0]); 
-        
-        // 3. Reproducción hasta llenar
-        while(nuevaPoblacion.size() < config.poblacionSize) {
-            // Selección (Padres)
-            // K = 10% Poblacion
-            int kTorneo = max(2, (int)(config.poblacionSize * 0.1));
-            
-            int p1Idx = seleccionTorneo(poblacion, kTorneo);
-            int p2Idx = seleccionTorneo(poblacion, kTorneo);
-            
-            // Cruce (0.9)
-            vector<int> h1 = poblacion[p1Idx].genotipo;
-            vector<int> h2 = poblacion[p2Idx].genotipo;
-            
-            if (aleatorioUniforme() < config.probCruce) {
-                cruceOX(poblacion[p1Idx].genotipo, poblacion[p2Idx].genotipo, h1, h2);
+        siguiente.copiarDesde(0, actual, mejorSlot);
+        optimoSiguiente[0] = optimoActual[mejorSlot];
+        
+        // 3. Reproducción hasta llenar: una tarea por pareja
+        // Cada pareja evalúa a lo sumo 2 hijos: si no cabe la generación entera en el presupuesto,
+        // solo las primeras cruzan/mutan y esta es la última generación (nunca se pasa del tope)
+        paresConVariacion = numPares;
+        if (config.maxEvaluaciones > 0) {
+            int restantes = config.maxEvaluaciones - evalCounter;
+            if (restantes < 2 * numPares) {
+                paresConVariacion = max(0, restantes / 2);
+                agotado = true;
             }
-            
-            // Mutación (Swap)
-            if (aleatorioUniforme() < config.probMutacion) mutarSwap(h1);
-            if (aleatorioUniforme() < config.probMutacion) mutarSwap(h2);
-            
-            // Evaluar Hijos
-            Individuo ind1, ind2;
-            ind1.genotipo = h1;
-            ind1.fitness = evaluarSolucion(h1, flujo, distancia);
-            ind2.genotipo = h2;
-            ind2.fitness = evaluarSolucion(h2, flujo, distancia);
-            
-            // Insertar (si cabe)
-            if (nuevaPoblacion.size() < config.poblacionSize) nuevaPoblacion.push_back(ind1);
-            if (nuevaPoblacion.size() < config.poblacionSize) nuevaPoblacion.push_back(ind2);
         }
+        for(int p=0; p<numPares; p++) semillas[p] = rng();
+        auto tarea = [this](int p, int hilo) { generarPareja(p, hilo); };
+        hilos->paraCada(numPares, tarea);
+        for(int p=0; p<numPares; p++) evalCounter += evalsPareja[p];
         
-        // Reemplazo completo
-        poblacion = nuevaPoblacion;
+        // Reemplazo completo (la matriz solo se actualiza en las posiciones que cambian)
+        for(int i=0; i<config.poblacionSize; i++) {
+            frecuencias.reemplazar(actual.genotipo(i), siguiente.genotipo(i));
+        }
+        actual.swap(siguiente); // Intercambio de buffers, O(1)
+        optimoActual.swap(optimoSiguiente);
         
         // Ordenar para siguiente generación (Elitismo fácil + Stats)
-        sort(poblacion.begin(), poblacion.end());
+        for(int i=0; i<config.poblacionSize; i++) orden[i] = i;
+        ordenarPorFitness(orden, actual.fitness);
+        gen++;
+        
+        // 4. Memético: BL periódica sobre los mejores
+        if (config.periodoBL > 0 && gen % config.periodoBL == 0 && !terminado()) pasoBL();
+    }
+    
+    // Cierre: la última generación aún no se ha comparado con el mejor global
+    void finalizar() {
+        if (actual.fitness[orden[0]] < mejorGlobalFit) {
+            mejorGlobalFit = actual.fitness[orden[0]];
+            mejorGlobal.assign(actual.genotipo(orden[0]), actual.genotipo(orden[0]) + n);
+        }
+        if (log.is_open()) log.close();
     }
     
-    if (logFile != "") log.close();
+    // Migración: un inmigrante sustituye al peor si lo mejora
+    bool recibirInmigrante(const int* genotipo, long long fit) {
+        int peor = orden.back();
+        if (fit >= actual.fitness[peor]) return false;
+        frecuencias.reemplazar(actual.genotipo(peor), genotipo);
+        actual.copiarGenotipo(peor, genotipo);
+        actual.fitness[peor] = fit;
+        optimoActual[peor] = 0;
+        recolocarUltimo(orden, actual.fitness);
+        if (fit < mejorGlobalFit) {
+            mejorGlobalFit = fit;
+            mejorGlobal.assign(genotipo, genotipo + n);
+        }
+        return true;
+    }
+    
+    // Emigrantes: los 'i'-ésimos mejores de la población viva
+    const int* individuo(int i) const { return actual.genotipo(orden[i]); }
+    long long fitnessIndividuo(int i) const { return actual.fitness[orden[i]]; }
+};
+
+ResultadoAGG geneticoGeneracional(const vector<vector<int>>& flujo, const vector<vector<int>>& distancia, ConfigAGG config, string logFile = "") {
+    EstadoAGG estado;
+    estado.inicializar(flujo, distancia, config, logFile);
+    
+    // Bucle Evolutivo
+    while (!estado.terminado()) estado.paso();
+    estado.finalizar();
     
     // Retornar mejor global histórico
-    return {mejorGlobal.genotipo, mejorGlobal.fitness};
+    return {estado.mejorGlobal, estado.mejorGlobalFit, estado.evalCounter};
 }
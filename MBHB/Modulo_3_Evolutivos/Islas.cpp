@@ -0,0 +1,203 @@
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <memory>
+#include <algorithm>
+
+// Modelo de Islas
+// Varias poblaciones (AGG y/o CHC, mezclables) evolucionan en paralelo, una por hilo, y cada
+// 'intervaloMigracion' generaciones locales envían copias de sus mejores individuos a sus vecinas
+// según la topología. Cada enlace dirigido es una cola SPSC sin cerrojos: la isla origen es el
+// único productor y la destino el único consumidor, así que ninguna isla espera a otra.
+// Las migraciones son asíncronas: el momento en que llega un migrante depende de la velocidad
+// relativa de los hilos, por lo que el resultado con una misma semilla puede variar entre ejecuciones.
+// Asume incluidos antes GeneticAlgorithm.cpp (EstadoAGG) y CHCAlgorithm.cpp (EstadoCHC).
+
+using namespace std;
+
+enum TipoIsla { ISLA_AGG, ISLA_CHC };
+
+enum TopologiaIslas {
+    TOPOLOGIA_ANILLO,       // i -> i+1
+    TOPOLOGIA_ANILLO_DOBLE, // i -> i+1 e i -> i-1
+    TOPOLOGIA_COMPLETA      // i -> todas las demás
+};
+
+struct ConfigIslas {
+    vector<TipoIsla> islas = {ISLA_AGG, ISLA_AGG, ISLA_CHC, ISLA_CHC};
+    TopologiaIslas topologia = TOPOLOGIA_ANILLO;
+    int intervaloMigracion = 10; // Generaciones locales entre migraciones
+    int numMigrantes = 2;        // Mejores enviados a cada vecina en cada migración
+    int capacidadCola = 8;       // Migrantes en tránsito por enlace; con la cola llena se descartan los nuevos
+    ConfigAGG configAGG;         // Parada de las islas AGG: maxGeneraciones
+    ConfigCHC configCHC;         // Parada de las islas CHC: maxEvaluaciones
+};
+
+struct ResultadoIslas {
+    vector<int> mejorSolucion;
+    long long mejorCoste;
+    vector<long long> mejorPorIsla;
+    long long migrantesEnviados = 0;
+    long long migrantesAceptados = 0; // Mejoraban al peor de la isla destino (y no estaban ya en ella, en CHC)
+    long long migrantesPerdidos = 0;  // Cola llena
+};
+
+// Cola SPSC acotada de migrantes (genotipo + fitness) sobre un búfer circular
+// 'cabeza' solo la escribe el consumidor y 'cola' solo el productor; el release/acquire sobre
+// 'cola' publica el genotipo copiado, y el de 'cabeza' devuelve el hueco al productor.
+// Cada índice va en su propia línea de caché para que productor y consumidor no se estorben.
+struct ColaMigrantes {
+    int capacidad;
+    int n;
+    vector<int> genes;
+    vector<long long> fitness;
+    alignas(64) atomic<size_t> cabeza{0}; // Siguiente a leer
+    alignas(64) atomic<size_t> cola{0};   // Siguiente a escribir
+
+    ColaMigrantes(int capacidad, int n) : capacidad(capacidad), n(n), genes((size_t)capacidad * n), fitness(capacidad) {}
+
+    // Solo desde la isla origen. false si la cola está llena (el migrante se pierde)
+    bool enviar(const int* genotipo, long long fit) {
+        size_t t = cola.load(memory_order_relaxed);
+        if (t - cabeza.load(memory_order_acquire) == (size_t)capacidad) return false;
+        size_t hueco = t % capacidad;
+        memcpy(genes.data() + hueco * n, genotipo, sizeof(int) * n);
+        fitness[hueco] = fit;
+        cola.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    // Solo desde la isla destino. false si no hay nada pendiente
+    bool recibir(int* genotipo, long long& fit) {
+        size_t h = cabeza.load(memory_order_relaxed);
+        if (h == cola.load(memory_order_acquire)) return false;
+        size_t hueco = h % capacidad;
+        memcpy(genotipo, genes.data() + hueco * n, sizeof(int) * n);
+        fit = fitness[hueco];
+        cabeza.store(h + 1, memory_order_release);
+        return true;
+    }
+};
+
+// Enlaces dirigidos (origen, destino) de la topología
+vector<pair<int, int>> enlacesTopologia(TopologiaIslas topologia, int numIslas) {
+    vector<pair<int, int>> enlaces;
+    if (numIslas < 2) return enlaces;
+    for(int i = 0; i < numIslas; i++) {
+        if (topologia == TOPOLOGIA_COMPLETA) {
+            for(int j = 0; j < numIslas; j++) if (j != i) enlaces.push_back({i, j});
+        } else {
+            enlaces.push_back({i, (i + 1) % numIslas});
+            // Con 2 islas el enlace hacia atrás ya es el de delante
+            if (topologia == TOPOLOGIA_ANILLO_DOBLE && numIslas > 2) enlaces.push_back({i, (i - 1 + numIslas) % numIslas});
+        }
+    }
+    return enlaces;
+}
+
+// Colas que tocan a una isla y sus contadores (solo los escribe el hilo de la isla)
+struct EnlacesIsla {
+    vector<ColaMigrantes*> salida;
+    vector<ColaMigrantes*> entrada;
+    long long enviados = 0, aceptados = 0, perdidos = 0;
+};
+
+// Emigrar los mejores a cada vecina y recoger todo lo que haya llegado
+// 'Estado' es EstadoAGG o EstadoCHC (misma interfaz de migración)
+template <typename Estado>
+void migrar(Estado& estado, EnlacesIsla& isla, int numMigrantes, vector<int>& migrante) {
+    int m = min(numMigrantes, (int)estado.orden.size());
+    for(ColaMigrantes* c : isla.salida) {
+        for(int i = 0; i < m; i++) {
+            if (c->enviar(estado.individuo(i), estado.fitnessIndividuo(i))) isla.enviados++;
+            else isla.perdidos++;
+        }
+    }
+    long long fit;
+    for(ColaMigrantes* c : isla.entrada) {
+        while (c->recibir(migrante.data(), fit)) {
+            if (estado.recibirInmigrante(migrante.data(), fit)) isla.aceptados++;
+        }
+    }
+}
+
+template <typename Estado, typename Config>
+void evolucionarIsla(const vector<vector<int>>& flujo, const vector<vector<int>>& distancia, const Config& config,
+                     const ConfigIslas& configIslas, EnlacesIsla& isla, string logFile,
+                     vector<int>& mejorSolucion, long long& mejorCoste) {
+    Estado estado;
+    estado.inicializar(flujo, distancia, config, logFile);
+    vector<int> migrante(flujo.size());
+
+    int generacion = 0;
+    while (!estado.terminado()) {
+        estado.paso();
+        if (++generacion % configIslas.intervaloMigracion == 0) {
+            migrar(estado, isla, configIslas.numMigrantes, migrante);
+        }
+    }
+
+    estado.finalizar();
+    mejorSolucion = estado.mejorGlobal;
+    mejorCoste = estado.mejorGlobalFit;
+}
+
+// Log por isla: <prefijoLog><i>.csv con el formato de su algoritmo
+ResultadoIslas modeloIslas(const vector<vector<int>>& flujo, const vector<vector<int>>& distancia, ConfigIslas config, string prefijoLog = "") {
+    int n = flujo.size();
+    int numIslas = config.islas.size();
+    config.intervaloMigracion = max(1, config.intervaloMigracion);
+    config.capacidadCola = max(1, config.capacidadCola);
+
+    // El paralelismo está entre islas: cada una corre en un solo hilo
+    ConfigAGG cfgAGG = config.configAGG;
+    ConfigCHC cfgCHC = config.configCHC;
+    cfgAGG.numHilos = 1;
+    cfgCHC.numHilos = 1;
+
+    // Una cola por enlace (las atómicas no se pueden mover: punteros estables)
+    vector<pair<int, int>> enlaces = enlacesTopologia(config.topologia, numIslas);
+    vector<unique_ptr<ColaMigrantes>> colas;
+    vector<EnlacesIsla> islas(numIslas);
+    for(auto& e : enlaces) {
+        colas.emplace_back(new ColaMigrantes(config.capacidadCola, n));
+        islas[e.first].salida.push_back(colas.back().get());
+        islas[e.second].entrada.push_back(colas.back().get());
+    }
+
+    // Semillas por isla, sacadas en orden del generador del hilo principal
+    vector<unsigned int> semillas(numIslas);
+    for(int i = 0; i < numIslas; i++) semillas[i] = rng();
+
+    vector<vector<int>> mejores(numIslas);
+    vector<long long> costes(numIslas, -1);
+    vector<thread> hilos;
+    for(int i = 0; i < numIslas; i++) {
+        hilos.emplace_back([&, i]() {
+            rng.seed(semillas[i]);
+            string logFile = (prefijoLog != "") ? prefijoLog + to_string(i) + ".csv" : "";
+            if (config.islas[i] == ISLA_AGG) {
+                evolucionarIsla<EstadoAGG>(flujo, distancia, cfgAGG, config, islas[i], logFile, mejores[i], costes[i]);
+            } else {
+                evolucionarIsla<EstadoCHC>(flujo, distancia, cfgCHC, config, islas[i], logFile, mejores[i], costes[i]);
+            }
+        });
+    }
+    for(auto& h : hilos) h.join();
+
+    ResultadoIslas res;
+    res.mejorCoste = -1;
+    res.mejorPorIsla = costes;
+    for(int i = 0; i < numIslas; i++) {
+        if (res.mejorCoste == -1 || costes[i] < res.mejorCoste) {
+            res.mejorCoste = costes[i];
+            res.mejorSolucion = mejores[i];
+        }
+        res.migrantesEnviados += islas[i].enviados;
+        res.migrantesAceptados += islas[i].aceptados;
+        res.migrantesPerdidos += islas[i].perdidos;
+    }
+    return res;
+}
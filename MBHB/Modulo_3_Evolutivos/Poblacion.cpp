@@ -0,0 +1,121 @@
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+using namespace std;
+
+// Población en Estructura de Arrays (SoA)
+// Todos los genotipos viven en un único bloque contiguo (slot i -> genes[i*n .. i*n+n)),
+// y el fitness en un array paralelo. Los algoritmos ordenan y seleccionan índices de slot,
+// nunca objetos: ya no se copian vector<int> al pasar de generación.
+struct PoblacionSoA {
+    int tam = 0; // Número de slots
+    int n = 0;   // Longitud del genotipo
+    vector<int> genes;
+    vector<long long> fitness;
+
+    void inicializar(int numSlots, int tamGenotipo) {
+        tam = numSlots;
+        n = tamGenotipo;
+        genes.assign((size_t)tam * n, 0);
+        fitness.assign(tam, -1);
+    }
+
+    int* genotipo(int slot) { return genes.data() + (size_t)slot * n; }
+    const int* genotipo(int slot) const { return genes.data() + (size_t)slot * n; }
+
+    void copiarGenotipo(int slotDestino, const int* origen) {
+        memcpy(genotipo(slotDestino), origen, sizeof(int) * n);
+    }
+
+    // Copia un individuo completo (genotipo + fitness) desde otra población
+    void copiarDesde(int slotDestino, const PoblacionSoA& otra, int slotOrigen) {
+        copiarGenotipo(slotDestino, otra.genotipo(slotOrigen));
+        fitness[slotDestino] = otra.fitness[slotOrigen];
+    }
+
+    void swap(PoblacionSoA& otra) {
+        std::swap(tam, otra.tam);
+        std::swap(n, otra.n);
+        genes.swap(otra.genes);
+        fitness.swap(otra.fitness);
+    }
+};
+
+// Ordena una lista de slots por fitness ascendente (mejor primero)
+void ordenarPorFitness(vector<int>::iterator inicio, vector<int>::iterator fin, const vector<long long>& fitness) {
+    sort(inicio, fin, [&](int a, int b) { return fitness[a] < fitness[b]; });
+}
+
+void ordenarPorFitness(vector<int>& slots, const vector<long long>& fitness) {
+    ordenarPorFitness(slots.begin(), slots.end(), fitness);
+}
+
+// Tras cambiar el fitness del último slot de una lista ordenada, lo lleva a su sitio (inserción, O(N))
+void recolocarUltimo(vector<int>& slots, const vector<long long>& fitness) {
+    int i = (int)slots.size() - 1;
+    int slot = slots[i];
+    for(; i > 0 && fitness[slots[i-1]] > fitness[slot]; i--) slots[i] = slots[i-1];
+    slots[i] = slot;
+}
+
+// Hash de genotipo (estilo Zobrist): suma de claves pseudoaleatorias por (posición, valor).
+// Las claves salen de splitmix64, así que no consume el generador global (no altera las semillas).
+uint64_t claveZobrist(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+uint64_t hashGenotipo(const int* genotipo, int n) {
+    uint64_t h = 0;
+    for(int i = 0; i < n; i++) {
+        h += claveZobrist((uint64_t)i * n + genotipo[i]);
+    }
+    return h;
+}
+
+// --- Evaluación de hijos por delta ---
+// Un hijo suele parecerse mucho a uno de sus padres (copia + swap, u OX en una población
+// convergida). Se toma como referencia el padre con menos posiciones distintas y se elige
+// el método exacto más barato:
+//   k == 0            -> fitness del padre, sin evaluar
+//   4k < n            -> calcularDeltaMultiple, O(k*n) (~4kn accesos frente a n^2)
+//   en otro caso      -> evaluación completa O(n^2)
+// 'posiciones' es un buffer de n enteros del llamador. Si se pasa 'evaluaciones', se suma 1
+// cuando realmente se evalúa (delta o completa): sirve para presupuestos por evaluaciones.
+// Usa evaluarSolucion/calcularDeltaMultiple de Core/Evaluador.cpp (incluido en main).
+int posicionesDistintas(const int* a, const int* b, int n, int* posiciones) {
+    int k = 0;
+    for(int i = 0; i < n; i++) {
+        posiciones[k] = i;
+        k += (a[i] != b[i]); // Sin saltos: se escribe siempre y solo avanza si difiere
+    }
+    return k;
+}
+
+long long evaluarHijo(const int* hijo, const int* padreA, long long fitA, const int* padreB, long long fitB, int n,
+                      const vector<vector<int>>& flujo, const vector<vector<int>>& distancia, int* posiciones,
+                      int* evaluaciones = nullptr) {
+    int k = posicionesDistintas(padreA, hijo, n, posiciones);
+    const int* ref = padreA;
+    long long fitRef = fitA;
+    
+    if (k > 0 && padreB != padreA) {
+        // Solo hace falta el recuento del otro padre si mejora; las posiciones se recalculan luego
+        int kB = 0;
+        for(int i = 0; i < n; i++) kB += (padreB[i] != hijo[i]);
+        if (kB < k) {
+            k = posicionesDistintas(padreB, hijo, n, posiciones);
+            ref = padreB;
+            fitRef = fitB;
+        }
+    }
+    
+    if (k == 0) return fitRef;
+    if (evaluaciones) (*evaluaciones)++;
+    if (4 * k < n) return fitRef + calcularDeltaMultiple(ref, hijo, posiciones, k, n, flujo, distancia);
+    return evaluarSolucion(hijo, n, flujo, distancia);
+}
@@ -3,131 +3,477 @@
 #include <algorithm>
 #include <chrono>
 #include <fstream>
+#include <array>
+#include <cstdint>
 #include "ACO_Graph.cpp"
 #include "Ant.cpp"
+#include "TSP_LocalSearch.cpp"
+#include "TSP_LinKernighan.cpp"
+
+// Asume Core/Paralelo.cpp incluido antes (PoolHilos)
 
 using namespace std;
 
-// TSP Greedy (Nearest Neighbor) para Tau0
-long long tspGreedy(const TSPInstance& inst) {
+// Coste de un camino cerrado con la distancia TSPLIB
+long long costeCamino(const TSPInstance& inst, const vector<int>& camino) {
+    long long coste = 0;
+    int n = camino.size();
+    conDistancia(inst, [&](auto d) {
+        for(int i=0; i<n; i++) coste += d(camino[i], camino[(i + 1) % n]);
+    });
+    return coste;
+}
+
+// TSP Greedy (Nearest Neighbor): tour completo desde la ciudad 0
+// La más cercana sin visitar sale del árbol k-d (a igual distancia, la de menor índice):
+// O(n log n) típico en lugar de O(n^2), con el mismo tour.
+SolucionTSP tourGreedy(const TSPInstance& inst) {
     int n = inst.n;
-    if(n==0) return 0;
+    SolucionTSP tour;
+    tour.coste = 0;
+    if(n==0) return tour;
     
-    vector<bool> visited(n, false);
+    ArbolKD arbol;
+    arbol.construir(inst);
+    ConjuntoKD libres;
+    libres.llenar(arbol);
     int current = 0;
-    visited[0] = true;
+    libres.borrar(arbol, 0);
+    tour.camino.push_back(0);
     long long cost = 0;
     
     for(int i=1; i<n; i++) {
-        int bestNext = -1;
-        int minD = 999999999;
-        
-        for(int j=0; j<n; j++) {
-            if(!visited[j]) {
-                int d = distanciaEuc(inst.ciudades[current], inst.ciudades[j]);
-                if (d < minD) {
-                    minD = d;
-                    bestNext = j;
-                }
-            }
-        }
-        current = bestNext;
-        visited[current] = true;
+        int minD;
+        current = arbol.masCercanaViva(libres, current, 0, &minD);
+        libres.borrar(arbol, current);
+        tour.camino.push_back(current);
         cost += minD;
     }
     // Cerrar
-    cost += distanciaEuc(inst.ciudades[current], inst.ciudades[0]);
-    return cost;
+    cost += distanciaTSP(inst, current, 0);
+    tour.coste = cost;
+    return tour;
+}
+
+// Greedy de aristas: las aristas entre k vecinos, de más corta a más larga, entran si ninguno de
+// sus extremos tiene ya grado 2 y no cierran un ciclo (union-find). Los fragmentos que quedan se
+// enlazan por vecino más cercano entre extremos libres (árbol k-d). En instancias uniformes queda
+// ~16% por encima del óptimo, frente al ~24% del vecino más cercano: mejor arranque para 2-opt o LK.
+int raizUF(vector<int>& padre, int x) {
+    while (padre[x] != x) x = padre[x] = padre[padre[x]];
+    return x;
+}
+
+SolucionTSP tourGreedyAristas(const TSPInstance& inst, int k = 10) {
+    int n = inst.n;
+    SolucionTSP tour;
+    tour.coste = 0;
+    if (n < 3) {
+        for(int i=0; i<n; i++) tour.camino.push_back(i);
+        tour.coste = costeCamino(inst, tour.camino);
+        return tour;
+    }
+    k = min(k, n - 1);
+    ArbolKD arbol;
+    arbol.construir(inst);
+    
+    // Aristas candidatas (d, i, j) con i < j, sin repetir
+    vector<int> vecinos(k);
+    vector<pair<int, int>> monticulo;
+    vector<pair<int, pair<int, int>>> aristas;
+    aristas.reserve((size_t)n * k);
+    conDistancia(inst, [&](auto d) {
+        for(int i=0; i<n; i++) {
+            arbol.kVecinos(i, k, vecinos.data(), monticulo);
+            for(int j : vecinos) {
+                int a = min(i, j), b = max(i, j);
+                aristas.push_back({d(a, b), {a, b}});
+            }
+        }
+    });
+    sort(aristas.begin(), aristas.end());
+    aristas.erase(unique(aristas.begin(), aristas.end()), aristas.end());
+    
+    vector<int> grado(n, 0), padre(n);
+    vector<array<int, 2>> adyacentes(n, {-1, -1});
+    for(int i=0; i<n; i++) padre[i] = i;
+    int unidas = 0;
+    for(auto& e : aristas) {
+        int a = e.second.first, b = e.second.second;
+        if (grado[a] == 2 || grado[b] == 2) continue;
+        int ra = raizUF(padre, a), rb = raizUF(padre, b);
+        if (ra == rb) continue;
+        padre[ra] = rb;
+        adyacentes[a][grado[a]++] = b;
+        adyacentes[b][grado[b]++] = a;
+        if (++unidas == n - 1) break;
+    }
+    
+    // Otro extremo de cada fragmento (un camino; una ciudad suelta es su propio extremo)
+    vector<int> otroExtremo(n, -1);
+    for(int i=0; i<n; i++) {
+        if (grado[i] == 2 || otroExtremo[i] != -1) continue;
+        int previo = -1, c = i;
+        if (grado[i] == 1) {
+            do {
+                int sig = adyacentes[c][0] != previo ? adyacentes[c][0] : adyacentes[c][1];
+                previo = c;
+                c = sig;
+            } while (grado[c] == 2);
+        }
+        otroExtremo[i] = c;
+        otroExtremo[c] = i;
+    }
+    
+    // Recorrer fragmentos: al acabar uno, saltar al extremo libre más cercano
+    ConjuntoKD libres;
+    libres.llenar(arbol);
+    for(int i=0; i<n; i++) if (grado[i] == 2) libres.borrar(arbol, i);
+    int extremo = 0;
+    while (grado[extremo] == 2) extremo++;
+    tour.camino.reserve(n);
+    while (extremo != -1) {
+        int fin = otroExtremo[extremo];
+        libres.borrar(arbol, extremo);
+        libres.borrar(arbol, fin);
+        int previo = -1, c = extremo;
+        while (true) {
+            tour.camino.push_back(c);
+            if (c == fin) break;
+            int sig = adyacentes[c][0] != previo ? adyacentes[c][0] : adyacentes[c][1];
+            previo = c;
+            c = sig;
+        }
+        extremo = arbol.masCercanaViva(libres, fin);
+    }
+    tour.coste = costeCamino(inst, tour.camino);
+    return tour;
+}
+
+// Tour por curva de Hilbert: las ciudades ordenadas por su índice en la curva sobre una rejilla
+// 2^16 x 2^16 que cubre la caja envolvente. O(n log n) y sin consultas de vecinos; ~40% por
+// encima del óptimo en instancias uniformes, pero 6-8 veces más rápido que el vecino más cercano.
+// Una EXPLICIT sin coordenadas (DISPLAY_DATA_SECTION) arranca con el vecino más cercano.
+uint64_t indiceHilbert(uint32_t x, uint32_t y, int bits) {
+    uint32_t lado = 1u << bits;
+    uint64_t d = 0;
+    for(uint32_t s = lado / 2; s > 0; s >>= 1) {
+        uint32_t rx = (x & s) > 0, ry = (y & s) > 0;
+        d += (uint64_t)s * s * ((3 * rx) ^ ry);
+        if (ry == 0) { // Rotar el cuadrante
+            if (rx == 1) {
+                x = lado - 1 - x;
+                y = lado - 1 - y;
+            }
+            swap(x, y);
+        }
+    }
+    return d;
+}
+
+SolucionTSP tourHilbert(const TSPInstance& inst) {
+    int n = inst.n;
+    SolucionTSP tour;
+    tour.coste = 0;
+    if (n == 0) return tour;
+    if ((int)inst.ciudades.size() != n) return tourGreedy(inst);
+    double xmin = inst.ciudades[0].x, xmax = xmin, ymin = inst.ciudades[0].y, ymax = ymin;
+    for(const Ciudad& c : inst.ciudades) {
+        xmin = min(xmin, c.x); xmax = max(xmax, c.x);
+        ymin = min(ymin, c.y); ymax = max(ymax, c.y);
+    }
+    const int bits = 16;
+    double lado = max(max(xmax - xmin, ymax - ymin), 1e-9);
+    double escala = ((1 << bits) - 1) / lado;
+    vector<pair<uint64_t, int>> clave(n);
+    for(int i=0; i<n; i++) {
+        uint32_t x = (uint32_t)((inst.ciudades[i].x - xmin) * escala);
+        uint32_t y = (uint32_t)((inst.ciudades[i].y - ymin) * escala);
+        clave[i] = {indiceHilbert(x, y, bits), i};
+    }
+    sort(clave.begin(), clave.end());
+    tour.camino.resize(n);
+    for(int i=0; i<n; i++) tour.camino[i] = clave[i].second;
+    tour.coste = costeCamino(inst, tour.camino);
+    return tour;
+}
+
+// Coste del Greedy, para Tau0
+long long tspGreedy(const TSPInstance& inst) {
+    return tourGreedy(inst).coste;
+}
+
+// --- Lin-Kernighan encadenado (sin hormigas) ---
+// Tour inicial -> óptimo LK -> patadas double-bridge hasta agotar el tiempo (mismo presupuesto que el ACO)
+enum TourInicialTSP {
+    INICIAL_VECINO,  // Vecino más cercano (tourGreedy)
+    INICIAL_ARISTAS, // Greedy de aristas (tourGreedyAristas)
+    INICIAL_HILBERT  // Curva de Hilbert (tourHilbert)
+};
+
+struct ConfigLK {
+    TourInicialTSP inicial = INICIAL_ARISTAS;
+    double timeLimitSec = 180.0;
+    long long maxPatadas = 0;    // 0 = sin límite (solo tiempo)
+    int vecinos = 10;            // Vecinos por ciudad que prueba cada paso LK
+    int umbralDisperso = 5000;   // Como en ConfigACO: distancias sin matriz n x n desde este n
+    int umbralDosNiveles = 5000; // Como en ConfigACO
+};
+
+// El tiempo cuenta desde la entrada: tour inicial, grafo y listas de vecinos incluidos. Lo único que
+// puede pasarse de 'timeLimitSec' es el tour inicial: si ya lo agota, se devuelve sin mejorar
+SolucionTSP ejecutarLK(const TSPInstance& inst, ConfigLK config = ConfigLK()) {
+    auto inicio = chrono::steady_clock::now();
+    auto restanteSec = [&]() { return config.timeLimitSec - chrono::duration<double>(chrono::steady_clock::now() - inicio).count(); };
+    int n = inst.n;
+    SolucionTSP sol = config.inicial == INICIAL_VECINO ? tourGreedy(inst)
+                    : config.inicial == INICIAL_ARISTAS ? tourGreedyAristas(inst) : tourHilbert(inst);
+    if (n < 5 || (config.timeLimitSec > 0 && restanteSec() <= 0)) return sol;
+    ACOGraph grafo;
+    grafo.inicializar(inst, 1.0, config.umbralDisperso > 0 && n >= config.umbralDisperso);
+    int k = min(max(1, config.vecinos), n - 1);
+    vector<int> vecinos = grafo.vecinosMasCercanos(k);
+    LinKernighanTSPAuto lk;
+    lk.preparar(grafo, vecinos.data(), k, config.umbralDosNiveles);
+    lk.mejorar(sol, config.timeLimitSec > 0 ? max(1e-3, restanteSec()) : 0.0, config.maxPatadas, rng());
+    return sol;
 }
 
 // Configuración Variante
-enum class VarianteACO { SYSTEMA_HORMIGAS, ELITISTA };
+// MAX_MIN (MMAS): solo deposita la mejor de la iteración o la mejor global, con tau acotado en
+// [tauMin, tauMax] y reinicio de la feromona al estancarse.
+// SISTEMA_COLONIA (ACS): regla pseudoaleatoria proporcional (q0), actualización local de las
+// aristas usadas y global solo sobre la mejor global, sin evaporar el resto del grafo.
+enum class VarianteACO { SYSTEMA_HORMIGAS, ELITISTA, MAX_MIN, SISTEMA_COLONIA };
+
+// Búsqueda local (2-opt + Or-opt) sobre los tours de las hormigas
+enum BusquedaLocalACO {
+    BL_NINGUNA,         // ACO puro (guía)
+    BL_MEJOR_ITERACION, // Solo la mejor hormiga de cada iteración
+    BL_TODAS            // Todas las hormigas (en paralelo, dentro de la construcción)
+};
+
+enum MotorBusquedaLocal {
+    MOTOR_2OPT, // 2-opt + Or-opt (BusquedaLocalTSP)
+    MOTOR_LK    // Lin-Kernighan (LinKernighanTSP), con patadas si patadasLK > 0
+};
+
+// Parámetros de ejecución (por defecto los de la guía: 30 hormigas, 3 minutos)
+struct ConfigACO {
+    int numHormigas = 30;
+    int numCandidatos = 20;      // Vecinos más cercanos por ciudad (0 = recorrer todas las ciudades)
+    double timeLimitSec = 180.0; // Control de Tiempo (3 min = 180 seg)
+    int maxIteraciones = 0;      // 0 = sin límite (solo tiempo); útil para ejecuciones reproducibles
+    int numHilos = 0;            // Hilos para construir la colonia (0 = todos los núcleos). El resultado por iteración no depende de este valor.
+    int umbralDisperso = 5000;   // Desde este n, grafo sin matrices n x n (ACOGraph::disperso); 0 = nunca
+    DisposicionMatriz disposicion = MATRIZ_COMPLETA; // Matrices densas: completa o triangular empaquetada (mismo resultado, mitad de memoria)
+    BusquedaLocalACO busquedaLocal = BL_NINGUNA;
+    MotorBusquedaLocal motorBL = MOTOR_2OPT;
+    int patadasLK = 0;           // Patadas double-bridge por llamada a LK (sin pasar de timeLimitSec)
+    int vecinosBL = 10;          // Vecinos por ciudad que prueba la búsqueda local
+    int umbralDosNiveles = 5000; // Desde este n, la búsqueda local usa TourDosNiveles en vez de TourArray; 0 = nunca
+    // MMAS
+    double pMejor = 0.05;        // Prob. de reconstruir la mejor global con la feromona convergida (fija tauMin)
+    int periodoMejorGlobal = 10; // Cada cuántas iteraciones deposita la mejor global (el resto, la de la iteración)
+    int reinicioMMAS = 250;      // Iteraciones sin mejorar la global antes de reiniciar tau a tauMax (0 = nunca)
+    // ACS
+    double q0 = 0.9;             // Prob. de elegir la mejor arista en vez de la ruleta
+    double xi = 0.1;             // Peso de la actualización local hacia tau0
+};
 
 struct ResultadoACO {
     SolucionTSP mejorSolucion;
     long long evaluaciones; // Iteraciones o tours construidos
 };
 
-ResultadoACO ejecutarACO(const TSPInstance& inst, VarianteACO variante, string logFile = "") {
+ResultadoACO ejecutarACO(const TSPInstance& inst, VarianteACO variante, string logFile = "", ConfigACO config = ConfigACO()) {
     int n = inst.n;
-    int m = 30; // Numero de hormigas (Guía)
+    int m = config.numHormigas; // Numero de hormigas (Guía: 30)
     
     // 1. Inicialización Greedy para Tau0
-    long long greedyCost = tspGreedy(inst);
+    SolucionTSP greedy = tourGreedy(inst);
+    long long greedyCost = greedy.coste;
     double tau0 = 1.0 / (double)(n * greedyCost);
+    bool mmas = variante == VarianteACO::MAX_MIN, acs = variante == VarianteACO::SISTEMA_COLONIA;
     
     cout << "[ACO] Greedy Init Cost: " << greedyCost << " -> Tau0: " << tau0 << endl;
     
+    // Instancias grandes: las matrices densas no caben (n = 100k son ~200 GB), memoria O(n*k)
+    // GEO y EXPLICIT se quedan en el denso (distancias sin coordenadas planas o ya en matriz)
+    bool disperso = config.umbralDisperso > 0 && n >= config.umbralDisperso && metricaMonotona(inst.metrica);
+    if (disperso) {
+        if (config.numCandidatos <= 0) config.numCandidatos = ConfigACO().numCandidatos; // Las listas son obligatorias
+        cout << "[ACO] Modo disperso: feromona solo en " << config.numCandidatos << " candidatos por ciudad" << endl;
+    }
+    
     ACOGraph grafo;
-    grafo.inicializar(inst, tau0);
+    grafo.disposicion = config.disposicion;
+    if (mmas) { // MMAS arranca en tauMax
+        tau0 = 1.0 / (grafo.rho * (double)greedyCost);
+        cout << "[ACO] MMAS: Tau0 = TauMax = " << tau0 << endl;
+    }
+    grafo.inicializar(inst, tau0, disperso);
+    grafo.construirCandidatos(config.numCandidatos);
+    if (acs) grafo.q0 = config.q0;
+    // MMAS: tauMax = 1/(rho*L) y tauMin tal que, convergida la feromona, la mejor global se
+    // reconstruye con probabilidad pMejor (Stützle y Hoos), con L el mejor coste conocido
+    auto acotarMMAS = [&](long long coste) {
+        double pDec = pow(config.pMejor, 1.0 / n);
+        double media = max(2.0, (config.numCandidatos > 0 ? min(config.numCandidatos, n - 1) : n) / 2.0);
+        grafo.tauMax = 1.0 / (grafo.rho * (double)coste);
+        grafo.tauMin = min(grafo.tauMax, grafo.tauMax * (1.0 - pDec) / ((media - 1.0) * pDec));
+    };
+    if (mmas) acotarMMAS(greedyCost);
+    grafo.actualizarInfoEleccion();
     
     SolucionTSP mejorGlobal;
     mejorGlobal.coste = -1;
     
     vector<Hormiga> colonia(m, Hormiga(n));
     
+    // Búsqueda local: listas de vecinos compartidas, estado (tour, cola) por hilo
+    bool conBL = config.busquedaLocal != BL_NINGUNA && n >= 5;
+    bool conLK = conBL && config.motorBL == MOTOR_LK;
+    int kBL = min(max(1, config.vecinosBL), n - 1);
+    vector<int> vecinosBL;
+    PoolHilos hilos(config.numHilos);
+    vector<BusquedaLocalTSPAuto> bls(conBL && !conLK ? hilos.numHilos() : 0);
+    vector<LinKernighanTSPAuto> lks(conLK ? hilos.numHilos() : 0);
+    if (conBL) vecinosBL = grafo.vecinosMasCercanos(kBL);
+    for(auto& bl : bls) bl.preparar(grafo, vecinosBL.data(), kBL, config.umbralDosNiveles);
+    for(auto& lk : lks) lk.preparar(grafo, vecinosBL.data(), kBL, config.umbralDosNiveles);
+    // Las patadas de LK usan el tiempo que quede (actualizado en cada iteración) y una semilla
+    // del que llama, para no depender del hilo
+    double restanteSec = config.timeLimitSec;
+    auto mejorarTour = [&](SolucionTSP& sol, int hilo, unsigned int semilla) {
+        if (conLK) lks[hilo].mejorar(sol, config.patadasLK > 0 ? max(1e-3, restanteSec) : 0.0, (long long)config.patadasLK, semilla);
+        else bls[hilo].mejorar(sol);
+    };
+    if (conBL) {
+        // El Greedy mejorado es el primer mejor global (Tau0 sigue saliendo del Greedy puro)
+        mejorGlobal = greedy;
+        mejorarTour(mejorGlobal, 0, conLK ? rng() : 0); // Sin LK no se consume el generador
+        cout << "[ACO] Greedy + " << (conLK ? "LK" : "2-opt/Or-opt") << ": " << mejorGlobal.coste << endl;
+        if (mmas) acotarMMAS(mejorGlobal.coste);
+    }
+    
+    // Construcción en paralelo: cada hormiga con su flujo aleatorio y cada hilo con sus buffers de ruleta
+    // Las semillas salen en orden del generador principal, así que no dependen del número de hilos
+    for(int k=0; k<m; k++) colonia[k].sembrar(rng());
+    vector<EspacioTrabajo> ws(hilos.numHilos());
+    for(auto& w : ws) w.reservar(n);
+    auto construir = [&](int k, int hilo) {
+        colonia[k].reset();
+        colonia[k].construirTour(grafo, ws[hilo]);
+        if (conBL && config.busquedaLocal == BL_TODAS) mejorarTour(colonia[k].tour, hilo, colonia[k].generador());
+    };
+    
     ofstream log;
     if(logFile != "") {
         log.open(logFile);
         log << "TimeSec,MejorCoste\n";
     }
     
-    // Control de Tiempo (3 min = 180 seg)
+    // Control de Tiempo
     auto start = chrono::high_resolution_clock::now();
-    double timeLimitSec = 180.0; 
+    double timeLimitSec = config.timeLimitSec;
     
     int iteracion = 0;
+    int ultimaMejora = 0; // MMAS: iteración de la última mejora global (o reinicio)
     
     while(true) {
         // Check tiempo
         auto now = chrono::high_resolution_clock::now();
         double elapsed = chrono::duration<double>(now - start).count();
         if (elapsed > timeLimitSec) break;
+        if (config.maxIteraciones > 0 && iteracion >= config.maxIteraciones) break;
+        restanteSec = timeLimitSec - elapsed;
         
         iteracion++;
         
         // --- 1. Construcción de Soluciones ---
-        // Paralelizable en OpenMP si se quisiera, pero secuencial por ahora
+        // Las hormigas solo leen el grafo: se construyen en paralelo. Todo lo que viene después
+        // (mejor global, aporte) se recorre en orden de hormiga, así que empates y sumas de
+        // feromona no dependen del reparto entre hilos.
+        hilos.paraCada(m, construir);
+        
+        if (conBL && config.busquedaLocal == BL_MEJOR_ITERACION) {
+            int mejorK = 0;
+            for(int k=1; k<m; k++) if (colonia[k].tour.coste < colonia[mejorK].tour.coste) mejorK = k;
+            mejorarTour(colonia[mejorK].tour, 0, colonia[mejorK].generador());
+        }
+        
+        int mejorIter = 0;
         for(int k=0; k<m; k++) {
-            colonia[k].reset();
-            colonia[k].construirTour(grafo);
-            
-            // Actualizar Global
+            if (colonia[k].tour.coste < colonia[mejorIter].tour.coste) mejorIter = k;
+            // Actualizar Global (a igualdad, la primera hormiga)
             if (mejorGlobal.coste == -1 || colonia[k].tour.coste < mejorGlobal.coste) {
                 mejorGlobal = colonia[k].tour;
+                ultimaMejora = iteracion;
+                if (mmas) acotarMMAS(mejorGlobal.coste);
                 cout << "Nueva Mejor (Iter " << iteracion << "): " << mejorGlobal.coste << " [" << elapsed << "s]" << endl;
             }
         }
         
-        // --- 2. Evaporación ---
-        grafo.evaporar();
-        
-        // --- 3. Aporte de Feromona ---
-        
-        // A) Todas las hormigas aportan (Sistema SH)
-        for(int k=0; k<m; k++) {
-            double delta = 1.0 / (double)colonia[k].tour.coste;
-            const vector<int>& ruta = colonia[k].tour.camino;
-            for(int i=0; i<n; i++) {
-                int u = ruta[i];
-                int v = ruta[(i+1)%n]; // Ciclo
-                grafo.depositar(u, v, delta);
+        // --- 2-3. Evaporación y aporte de feromona ---
+        if (mmas) {
+            // Estancamiento: vuelta a tauMax en todo el grafo, conservando la mejor global
+            if (config.reinicioMMAS > 0 && iteracion - ultimaMejora >= config.reinicioMMAS) {
+                grafo.reiniciarFeromona(grafo.tauMax);
+                ultimaMejora = iteracion;
+            } else {
+                grafo.evaporar();
+                bool global = config.periodoMejorGlobal > 0 && iteracion % config.periodoMejorGlobal == 0;
+                const SolucionTSP& elegida = global ? mejorGlobal : colonia[mejorIter].tour;
+                double delta = 1.0 / (double)elegida.coste;
+                for(int i=0; i<n; i++) grafo.depositarAcotado(elegida.camino[i], elegida.camino[(i+1)%n], delta);
             }
-        }
-        
-        // B) Aporte Elitista (Solo SHE)
-        if (variante == VarianteACO::ELITISTA) {
-            // Peso: e * contribucion_mejor
-            // Guia: e = m (30)
-            double deltaElite = (double)m * (1.0 / (double)mejorGlobal.coste); // Peso aumentado
+        } else if (acs) {
+            // Actualización local: en ACS se aplica al cruzar cada arista; aquí, con las hormigas
+            // construyendo en paralelo sobre el grafo de solo lectura, se aplica al terminar la
+            // iteración en orden de hormiga (resultado independiente del número de hilos)
+            for(int k=0; k<m; k++) {
+                const vector<int>& ruta = colonia[k].tour.camino;
+                for(int i=0; i<n; i++) grafo.mezclar(ruta[i], ruta[(i+1)%n], config.xi, tau0);
+            }
+            // Actualización global: solo las aristas de la mejor global
+            double delta = 1.0 / (double)mejorGlobal.coste;
             const vector<int>& ruta = mejorGlobal.camino;
-            for(int i=0; i<n; i++) {
-                int u = ruta[i];
-                int v = ruta[(i+1)%n];
-                grafo.depositar(u, v, deltaElite);
+            for(int i=0; i<n; i++) grafo.mezclar(ruta[i], ruta[(i+1)%n], grafo.rho, delta);
+        } else {
+            // --- 2. Evaporación ---
+            grafo.evaporar();
+            
+            // --- 3. Aporte de Feromona ---
+            
+            // A) Todas las hormigas aportan (Sistema SH)
+            for(int k=0; k<m; k++) {
+                double delta = 1.0 / (double)colonia[k].tour.coste;
+                const vector<int>& ruta = colonia[k].tour.camino;
+                for(int i=0; i<n; i++) {
+                    int u = ruta[i];
+                    int v = ruta[(i+1)%n]; // Ciclo
+                    grafo.depositar(u, v, delta);
+                }
+            }
+            
+            // B) Aporte Elitista (Solo SHE)
+            if (variante == VarianteACO::ELITISTA) {
+                // Peso: e * contribucion_mejor
+                // Guia: e = m (30)
+                double deltaElite = (double)m * (1.0 / (double)mejorGlobal.coste); // Peso aumentado
+                const vector<int>& ruta = mejorGlobal.camino;
+                for(int i=0; i<n; i++) {
+                    int u = ruta[i];
+                    int v = ruta[(i+1)%n];
+                    grafo.depositar(u, v, deltaElite);
+                }
             }
         }
         
+        // --- 4. Información de elección para la siguiente iteración ---
+        grafo.actualizarInfoEleccion();
+        
         if (logFile != "") {
             log << elapsed << "," << mejorGlobal.coste << "\n";
         }
@@ -1,15 +1,61 @@
 #include <vector>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "TSP_Data.cpp"
 
 using namespace std;
 
+// Precisión de feromona, eta^beta e infoEleccion. Con -DACO_FLOAT se guardan en float: mitad de
+// memoria y de ancho de banda (las sumas de la ruleta siguen en double). Por defecto, double.
+#ifdef ACO_FLOAT
+typedef float RealACO;
+#else
+typedef double RealACO;
+#endif
+
+// Disposición de las matrices simétricas n x n del modo denso (distancias, feromona, eta^beta)
+enum DisposicionMatriz {
+    MATRIZ_COMPLETA,  // n x n por filas: (i, j) y (j, i) se guardan y actualizan por separado
+    MATRIZ_TRIANGULAR // Triángulo superior empaquetado (con diagonal), n(n+1)/2: cada arista una vez
+};
+// La triangular ocupa la mitad, pero media fila de i es una columna (acceso con salto ~n). Con listas de
+// candidatos la recorre entera el recurso de lista agotada (mejorNoVisitado), así que en tiempo solo compensa
+// cuando la completa no cabe en memoria; en n = 3000 con k = 20 construye ~2.3x menos tours por segundo.
+
+// Potencia entera resuelta en compilación por cuadrados sucesivos: x^E sin llamar a pow
+template <int E>
+double potenciaEntera(double x) {
+    if constexpr (E == 0) return 1.0;
+    else if constexpr (E % 2 == 0) {
+        double h = potenciaEntera<E / 2>(x);
+        return h * h;
+    }
+    else return x * potenciaEntera<E - 1>(x);
+}
+
 // Grafo ACO centraliza las matrices de información (shared memory environment)
 struct ACOGraph {
     int n;
-    vector<vector<int>> distancias;
-    vector<vector<double>> visibilidad; // eta = 1/d
-    vector<vector<double>> feromona;    // tau
+    // Matrices densas aplanadas: la arista (i, j) está en indice(i, j). Fijar 'disposicion' antes de inicializar.
+    // eta = 1/d no se guarda: se eleva directamente a visibilidadBeta.
+    DisposicionMatriz disposicion = MATRIZ_COMPLETA;
+    vector<int> distancias;
+    vector<RealACO> feromona; // tau / escalaFeromona (leer con tau(i, j))
+    
+    // Modo disperso (instancias grandes): sin matrices n x n. Las distancias se calculan al vuelo
+    // desde las coordenadas (solo métricas monótonas: EUC_2D, CEIL_2D, ATT) y la feromona solo se guarda en las aristas de las listas de candidatos
+    // (n x k, paralela a 'candidatos'); el resto de aristas comparte 'feromonaResto', que evapora
+    // pero nunca recibe aporte. Memoria O(n*k). Exige listas de candidatos (k >= 1).
+    // La feromona de (i, j) es la de la lista de i: si j no está en ella vale feromonaResto,
+    // aunque i sí esté en la lista de j.
+    bool disperso = false;
+    vector<Ciudad> ciudades; // Para las distancias al vuelo del modo disperso
+    MetricaTSP metrica = METRICA_EUC_2D;
+    ArbolKD arbol;           // Listas de vecinos y, en modo disperso, la ciudad libre más cercana (apunta a la instancia)
+    vector<RealACO> feromonaCandidatos;
+    double feromonaResto = 0.0;
     
     // Config
     double alpha = 2.0; // Peso feromona -> Guía dice 1? No, guia dice "alpha=1, beta=2"? 
@@ -18,40 +64,274 @@ struct ACOGraph {
     double beta = 2.0;  // Peso visibilidad
     double rho = 0.15;  // Evaporación (User prompt says 0.15)
     double tau0;        // Feromona inicial
+    double tauMin = 1e-10; // Cota inferior de tau (evita el 0 absoluto), aplicada al leer
+    double tauMax = numeric_limits<double>::infinity(); // Cota superior (MMAS), aplicada al leer y en depositarAcotado
+    double q0 = 0.0;       // Regla pseudoaleatoria proporcional (ACS): con prob. q0 se elige la mejor arista
+    
+    // Evaporación perezosa: tau real = escalaFeromona * feromona almacenada
+    // Evaporar multiplica solo la escala, O(1); el aporte divide por ella y toca únicamente las
+    // aristas que recibe. Cuando la escala se hace muy pequeña se vuelca sobre la matriz (O(n^2),
+    // una vez cada ~2200 iteraciones con rho = 0.15 en double, ~270 en float).
+    double escalaFeromona = 1.0;
     
-    void inicializar(const TSPInstance& tsp, double t0) {
+    // Listas de candidatos: los k vecinos más cercanos de cada ciudad (n x k aplanada,
+    // de más cerca a más lejos). La construcción elige entre ellos y solo recorre todas
+    // las ciudades cuando están todos visitados: O(n*k) por tour en lugar de O(n^2).
+    int numCandidatos = 0; // 0 = sin listas (se recorren todas las ciudades)
+    vector<int> candidatos;
+    
+    // Información heurística de elección: infoEleccion = tau^alpha * eta^beta
+    // Se recalcula una vez por iteración (tras el aporte de feromona), no en cada paso de cada hormiga.
+    // Con listas es n x k, paralela a 'candidatos'; sin ellas, n x n aplanada.
+    // eta no cambia: eta^beta se eleva una sola vez (o cuando cambia beta).
+    vector<RealACO> infoEleccion;
+    vector<RealACO> visibilidadBeta; // Con la disposición de las matrices (n x k en modo disperso)
+    double betaCalculada = -1.0;
+    
+    void inicializar(const TSPInstance& tsp, double t0, bool modoDisperso = false) {
         n = tsp.n;
         tau0 = t0;
-        distancias.assign(n, vector<int>(n));
-        visibilidad.assign(n, vector<double>(n));
-        feromona.assign(n, vector<double>(n, tau0));
+        disperso = modoDisperso && metricaMonotona(tsp.metrica);
+        metrica = tsp.metrica;
+        arbol.construir(tsp);
+        if (disperso) {
+            ciudades = tsp.ciudades;
+            // Las matrices densas quedan vacías; candidatos y feromona llegan en construirCandidatos
+            feromonaResto = tau0;
+            return;
+        }
+        distancias.assign(tamMatriz(), 0);
+        feromona.assign(tamMatriz(), (RealACO)tau0);
         
-        for(int i=0; i<n; i++) {
-            for(int j=i+1; j<n; j++) { // Simétrica
-                int d = distanciaEuc(tsp.ciudades[i], tsp.ciudades[j]);
-                if(d == 0) d = 1; // Evitar div/0
-                
-                distancias[i][j] = distancias[j][i] = d;
-                visibilidad[i][j] = visibilidad[j][i] = 1.0 / (double)d;
+        conDistancia(tsp, [&](auto dist) {
+            for(int i=0; i<n; i++) {
+                for(int j=i+1; j<n; j++) { // Simétrica (en la triangular ambos índices coinciden)
+                    int d = dist(i, j); // Sin retocar: la visibilidad es la que evita div/0
+                    
+                    distancias[indice(i, j)] = distancias[indice(j, i)] = d;
+                }
             }
+        });
+    }
+    
+    size_t tamMatriz() const {
+        return (disposicion == MATRIZ_COMPLETA) ? (size_t)n * n : (size_t)n * (n + 1) / 2;
+    }
+    
+    // Posición de la arista (i, j) en las matrices densas
+    // Triangular: la fila i empieza tras las filas 0..i-1, de n, n-1, ..., n-i+1 elementos
+    size_t indice(int i, int j) const {
+        if (disposicion == MATRIZ_COMPLETA) return (size_t)i * n + j;
+        if (i > j) swap(i, j);
+        return (size_t)i * n - (size_t)i * (i - 1) / 2 + (j - i);
+    }
+    
+    // Distancia entera de la arista (i, j): de la matriz o, en modo disperso, de las coordenadas.
+    // Es la TSPLIB tal cual (0 entre ciudades repetidas), la misma que costeCamino: costes de
+    // hormigas, ganancias de la búsqueda local y del LK y el Greedy se miden igual
+    int distancia(int i, int j) const {
+        if (!disperso) return distancias[indice(i, j)];
+        const Ciudad* c = ciudades.data();
+        return metrica == METRICA_EUC_2D ? DistanciaEuc2D{c}(i, j)
+             : metrica == METRICA_CEIL_2D ? DistanciaCeil2D{c}(i, j) : DistanciaAtt{c}(i, j);
+    }
+    
+    // Listas de candidatos (ver vecinosMasCercanos); k se acota a n-1
+    void construirCandidatos(int k) {
+        numCandidatos = max(disperso ? 1 : 0, min(k, n - 1));
+        candidatos = vecinosMasCercanos(numCandidatos);
+        if (disperso) {
+            feromonaCandidatos.assign((size_t)n * numCandidatos, tau0 / escalaFeromona);
+            betaCalculada = -1.0; // visibilidadBeta sigue a las listas
         }
     }
     
-    // Evaporación Global: tau = (1-rho)*tau
-    void evaporar() {
-        double factor = (1.0 - rho);
-        for(int i=0; i<n; i++) {
-            for(int j=0; j<n; j++) {
-                feromona[i][j] *= factor;
-                // Clamp mínimo para evitar 0 absoluto (opcional, pero recomendado en ACS/MMAS)
-                if (feromona[i][j] < 1e-10) feromona[i][j] = 1e-10; 
+    // Los k vecinos más cercanos de cada ciudad (n x k aplanada, de más cerca a más lejos, a igual
+    // distancia el de menor índice), con la distancia del grafo. Consultas al árbol k-d:
+    // O(n log n) en total en lugar de O(n^2 log k) (con GEO o EXPLICIT, O(n^2)). k <= n-1.
+    vector<int> vecinosMasCercanos(int k) const {
+        vector<int> lista((size_t)n * k, 0);
+        if (k == 0) return lista;
+        vector<pair<int, int>> monticulo;
+        for(int i=0; i<n; i++) arbol.kVecinos(i, k, lista.data() + (size_t)i * k, monticulo);
+        return lista;
+    }
+    
+    // Posición de j en la lista de candidatos de i, o -1 (O(k))
+    int posicionCandidato(int i, int j) const {
+        const int* vecinos = candidatosDe(i);
+        for(int t=0; t<numCandidatos; t++) if (vecinos[t] == j) return t;
+        return -1;
+    }
+    
+    const int* candidatosDe(int i) const { return candidatos.data() + (size_t)i * numCandidatos; }
+    
+    // Recalcula infoEleccion. alpha entero pequeño (lo habitual) -> potencia resuelta en compilación;
+    // cualquier otro valor usa pow, pero solo aquí, una vez por arista y por iteración.
+    void actualizarInfoEleccion() {
+        if (betaCalculada != beta) {
+            if (disperso) {
+                visibilidadBeta.assign((size_t)n * numCandidatos, 0.0);
+                for(int i=0; i<n; i++) {
+                    const int* vecinos = candidatosDe(i);
+                    for(int t=0; t<numCandidatos; t++)
+                        visibilidadBeta[(size_t)i * numCandidatos + t] = pow(1.0 / max(1, distancia(i, vecinos[t])), beta);
+                }
+            } else {
+                visibilidadBeta.assign(tamMatriz(), 0.0);
+                for(int i=0; i<n; i++)
+                    for(int j=i+1; j<n; j++)
+                        visibilidadBeta[indice(i, j)] = visibilidadBeta[indice(j, i)] = pow(1.0 / (double)max(1, distancia(i, j)), beta);
             }
+            betaCalculada = beta;
+        }
+        
+        switch (alphaEntero()) {
+            case 0: recalcularInfo<0>(); break;
+            case 1: recalcularInfo<1>(); break;
+            case 2: recalcularInfo<2>(); break;
+            case 3: recalcularInfo<3>(); break;
+            case 4: recalcularInfo<4>(); break;
+            case 5: recalcularInfo<5>(); break;
+            case 6: recalcularInfo<6>(); break;
+            default: recalcularInfo<-1>(); break;
         }
     }
     
+    double tau(int i, int j) const {
+        double almacenada;
+        if (!disperso) almacenada = feromona[indice(i, j)];
+        else {
+            int t = posicionCandidato(i, j);
+            almacenada = (t >= 0) ? feromonaCandidatos[(size_t)i * numCandidatos + t] : feromonaResto;
+        }
+        return min(max(escalaFeromona * almacenada, tauMin), tauMax);
+    }
+    
+    // alpha como entero en [0, 6], o -1 si no lo es
+    int alphaEntero() const {
+        return (alpha >= 0 && alpha <= 6 && alpha == floor(alpha)) ? (int)alpha : -1;
+    }
+    
+    // tau^alpha * eta^beta de una arista cualquiera (fuera de las listas: recurso de la construcción)
+    // Solo modo denso: en el disperso las aristas fuera de las listas comparten feromona y la
+    // mejor es simplemente la más cercana.
+    // A = alphaEntero(), resuelto por el llamador una vez por recorrido (como en recalcularInfo):
+    // misma potencia sin pow. Sin listas la fila completa ya está en infoEleccion.
+    template <int A>
+    double infoArista(int i, int j) const {
+        if (numCandidatos == 0) return infoEleccion[(size_t)i * n + j];
+        double t = tau(i, j);
+        double tauAlpha;
+        if constexpr (A < 0) tauAlpha = pow(t, alpha);
+        else tauAlpha = potenciaEntera<A>(t);
+        return tauAlpha * visibilidadBeta[indice(i, j)];
+    }
+    
+    template <int A>
+    void recalcularInfo() {
+        const double escala = escalaFeromona;
+        const double minimo = tauMin, maximo = tauMax;
+        auto potencia = [this, escala, minimo, maximo](double almacenada) {
+            double t = min(max(escala * almacenada, minimo), maximo);
+            if constexpr (A < 0) return pow(t, alpha);
+            else return potenciaEntera<A>(t);
+        };
+        if (disperso) {
+            // Todo va paralelo a las listas: feromona, eta^beta e infoEleccion son n x k
+            size_t total = (size_t)n * numCandidatos;
+            infoEleccion.resize(total);
+            for(size_t e=0; e<total; e++) infoEleccion[e] = potencia(feromonaCandidatos[e]) * visibilidadBeta[e];
+        } else if (numCandidatos > 0) {
+            infoEleccion.resize((size_t)n * numCandidatos);
+            for(int i=0; i<n; i++) {
+                const int* vecinos = candidatosDe(i);
+                RealACO* info = infoEleccion.data() + (size_t)i * numCandidatos;
+                for(int t=0; t<numCandidatos; t++) {
+                    size_t e = indice(i, vecinos[t]);
+                    info[t] = potencia(feromona[e]) * visibilidadBeta[e];
+                }
+            }
+        } else {
+            // Filas completas para la construcción; por simetría cada arista se calcula una vez
+            infoEleccion.resize((size_t)n * n);
+            for(int i=0; i<n; i++) {
+                RealACO* info = infoEleccion.data() + (size_t)i * n;
+                info[i] = 0.0;
+                for(int j=i+1; j<n; j++) {
+                    size_t e = indice(i, j);
+                    info[j] = infoEleccion[(size_t)j * n + i] = potencia(feromona[e]) * visibilidadBeta[e];
+                }
+            }
+        }
+    }
+    
+    // Evaporación Global: tau = (1-rho)*tau, O(1) sobre la escala
+    void evaporar() {
+        escalaFeromona *= (1.0 - rho);
+        // Lo almacenado crece como delta / escala: se vuelca antes de que se salga del rango de RealACO
+        if (escalaFeromona < 1.0 / sqrt((double)numeric_limits<RealACO>::max())) renormalizarFeromona();
+    }
+    
+    // Vuelca la escala sobre la matriz (y aplica las cotas) para que no se pierda precisión
+    void renormalizarFeromona() {
+        for(RealACO& f : feromonaCandidatos) f = min(max(escalaFeromona * f, tauMin), tauMax);
+        for(RealACO& f : feromona) f = min(max(escalaFeromona * f, tauMin), tauMax);
+        feromonaResto = min(max(escalaFeromona * feromonaResto, tauMin), tauMax);
+        escalaFeromona = 1.0;
+    }
+    
+    // Toda la feromona a 'valor' (reinicio de MMAS), O(n^2) o O(n*k)
+    void reiniciarFeromona(double valor) {
+        escalaFeromona = 1.0;
+        fill(feromonaCandidatos.begin(), feromonaCandidatos.end(), (RealACO)valor);
+        fill(feromona.begin(), feromona.end(), (RealACO)valor);
+        feromonaResto = valor;
+    }
+    
     // Aporte de Feromona: tau += delta
     void depositar(int i, int j, double delta) {
-        feromona[i][j] += delta;
-        feromona[j][i] += delta;
+        double d = delta / escalaFeromona;
+        if (disperso) {
+            // Solo se guarda en las listas: en la de i, en la de j, en ambas o en ninguna
+            int t = posicionCandidato(i, j);
+            if (t >= 0) feromonaCandidatos[(size_t)i * numCandidatos + t] += d;
+            t = posicionCandidato(j, i);
+            if (t >= 0) feromonaCandidatos[(size_t)j * numCandidatos + t] += d;
+            return;
+        }
+        feromona[indice(i, j)] += d;
+        if (disposicion == MATRIZ_COMPLETA) feromona[indice(j, i)] += d;
+    }
+    
+    // Actualizaciones que dependen del valor actual de la arista (tau acotado, no lo almacenado)
+    // tau = (1 - peso) * tau + peso * valor: regla local de ACS (peso xi, valor tau0) y regla
+    // global de ACS sobre el mejor tour (peso rho, valor 1/L), sin evaporar el resto del grafo
+    void mezclar(int i, int j, double peso, double valor) {
+        ajustar(i, j, [&](double t) { return (1.0 - peso) * t + peso * valor; });
+    }
+    
+    // tau = min(tau + delta, tauMax): aporte de MMAS (la cota inferior ya se aplica al leer)
+    void depositarAcotado(int i, int j, double delta) {
+        ajustar(i, j, [&](double t) { return min(t + delta, tauMax); });
+    }
+    
+private:
+    // Aplica f a cada copia almacenada de la arista (i, j), igual que depositar
+    template <class F>
+    void ajustar(int i, int j, F f) {
+        auto aplicar = [&](RealACO& almacenada) {
+            double t = min(max(escalaFeromona * almacenada, tauMin), tauMax);
+            almacenada = (RealACO)(f(t) / escalaFeromona);
+        };
+        if (disperso) {
+            int t = posicionCandidato(i, j);
+            if (t >= 0) aplicar(feromonaCandidatos[(size_t)i * numCandidatos + t]);
+            t = posicionCandidato(j, i);
+            if (t >= 0) aplicar(feromonaCandidatos[(size_t)j * numCandidatos + t]);
+            return;
+        }
+        aplicar(feromona[indice(i, j)]);
+        if (disposicion == MATRIZ_COMPLETA) aplicar(feromona[indice(j, i)]);
     }
 };
@@ -2,8 +2,10 @@
 #include <cmath>
 #include <set>
 #include <iostream>
+#include <random>
+#include <cstdint>
 // Asume ACO_Graph incluido o disponible
-// Asume Generador.cpp (aleatorioUniforme)
+// Asume EspacioTrabajo.cpp
 
 using namespace std;
 
@@ -15,87 +17,197 @@ struct SolucionTSP {
 class Hormiga {
 public:
     int n;
-    vector<bool> visitado;
+    vector<uint64_t> visitado; // Bitset: ciudad c en el bit c % 64 de la palabra c / 64
     SolucionTSP tour;
+    // Flujo aleatorio propio: la hormiga sigue igual sea cual sea el hilo que la construya.
+    // Se siembra una vez (sembrar) y continúa entre iteraciones; resembrar un mt19937 en cada
+    // tour costaría tanto como construir un tour pequeño.
+    mt19937 generador;
+    ConjuntoKD libres; // Modo disperso: las no visitadas en el árbol k-d del grafo (para agotar la lista)
     
     Hormiga(int numCiudades) : n(numCiudades) {
-        visitado.resize(n);
+        visitado.resize((n + 63) / 64);
         reset();
     }
     
+    void sembrar(unsigned int semilla) { generador.seed(semilla); }
+    
     void reset() {
-        fill(visitado.begin(), visitado.end(), false);
+        fill(visitado.begin(), visitado.end(), 0);
         tour.camino.clear();
         tour.camino.reserve(n);
         tour.coste = 0;
     }
     
-    void construirTour(const ACOGraph& grafo) {
+    // ws: buffers de candidatos/probabilidades, reutilizados en cada paso (uno por hilo)
+    void construirTour(const ACOGraph& grafo, EspacioTrabajo& ws) {
+        ws.reservar(n);
+        
+        if (grafo.disperso) libres.llenar(grafo.arbol);
+        
         // 1. Ciudad inicial aleatoria
-        int actual = aleatorio(0, n - 1);
-        marcar(actual);
+        int actual = uniform_int_distribution<int>(0, n - 1)(generador);
+        marcar(actual, grafo);
         
         // 2. Construir nodos restantes
         for(int step = 1; step < n; step++) {
-            int siguiente = seleccionarSiguiente(actual, grafo);
+            int siguiente = seleccionarSiguiente(actual, grafo, ws);
             
             // Sumar coste
-            tour.coste += grafo.distancias[actual][siguiente];
+            tour.coste += grafo.distancia(actual, siguiente);
             
             // Moverse
-            marcar(siguiente);
+            marcar(siguiente, grafo);
             actual = siguiente;
         }
         
         // 3. Cerrar ciclo (volver a inicio)
         int inicio = tour.camino[0];
-        tour.coste += grafo.distancias[actual][inicio];
+        tour.coste += grafo.distancia(actual, inicio);
     }
     
+    void construirTour(const ACOGraph& grafo) {
+        construirTour(grafo, espacioHilo());
+    }
+    
+    bool estaVisitada(int ciudad) const { return (visitado[ciudad >> 6] >> (ciudad & 63)) & 1; }
+    
 private:
-    void marcar(int ciudad) {
-        visitado[ciudad] = true;
+    void marcar(int ciudad, const ACOGraph& grafo) {
+        visitado[ciudad >> 6] |= (uint64_t)1 << (ciudad & 63);
         tour.camino.push_back(ciudad);
+        if (grafo.disperso) libres.borrar(grafo.arbol, ciudad);
     }
     
-    int seleccionarSiguiente(int actual, const ACOGraph& grafo) {
+    // Peso enmascarado sin saltos: 1.0 si la ciudad está libre, 0.0 si ya se visitó
+    double libre(int ciudad) const {
+        return (double)((~visitado[ciudad >> 6] >> (ciudad & 63)) & 1);
+    }
+    
+    // Primer t con acumulado[t] > r (búsqueda binaria sin saltos); num si no hay ninguno
+    static int buscarAcumulado(const double* acumulado, int num, double r) {
+        const double* base = acumulado;
+        int len = num;
+        while (len > 1) {
+            int mitad = len / 2;
+            base = (base[mitad] <= r) ? base + mitad : base;
+            len -= mitad;
+        }
+        return (int)(base - acumulado) + (*base <= r);
+    }
+    
+    // Ruleta sobre los pesos acumulados acumulado[0..num) (total = acumulado[num-1] > 0)
+    // Las posiciones visitadas tienen peso 0 (su acumulado repite el anterior) y nunca se eligen:
+    // el primer acumulado que supera r pertenece siempre a un peso positivo.
+    int ruleta(const double* acumulado, int num) {
+        double total = acumulado[num - 1];
+        double r = uniform_real_distribution<double>(0.0, 1.0)(generador) * total;
+        int t = buscarAcumulado(acumulado, num, r);
+        if (t == num) { // r == total por redondeo: el último con peso
+            t = num - 1;
+            while (t > 0 && acumulado[t - 1] == total) t--;
+        }
+        return t;
+    }
+    
+    int seleccionarSiguiente(int actual, const ACOGraph& grafo, EspacioTrabajo& ws) {
         // Regla Probabilística (Ruleta)
         // P_ij = [tau]^alpha * [eta]^beta / SUM(...)
+        // Los pesos tau^alpha * eta^beta vienen precalculados en grafo.infoEleccion (una vez por iteración).
+        // No se compactan los no visitados: cada peso se multiplica por su máscara (0/1) y se acumula,
+        // sin saltos que dependan del conjunto visitado; la ruleta es una búsqueda binaria.
+        // Sumar ceros es exacto: los acumulados coinciden con los de la ruleta sobre los no visitados.
+        double* acumulado = ws.reales.data();
         
-        vector<int> candidatos; // Ciudades no visitadas
-        vector<double> probs;
-        double sumProb = 0.0;
-        
-        candidatos.reserve(n);
-        probs.reserve(n);
+        // Regla pseudoaleatoria proporcional (ACS): con probabilidad q0 explota la mejor arista.
+        // Con q0 = 0 no se consume ningún número aleatorio (mismas secuencias que la ruleta sola)
+        if (grafo.q0 > 0 && uniform_real_distribution<double>(0.0, 1.0)(generador) < grafo.q0) {
+            int t = mejorPeso(actual, grafo);
+            if (t >= 0) return t;
+        }
         
-        for(int i=0; i<n; i++) {
-            if(!visitado[i]) {
-                double tau = grafo.feromona[actual][i];
-                double eta = grafo.visibilidad[actual][i];
-                
-                // Usamos pow lento? O optimizamos?
-                // alpha=2, beta=2 -> (tau*tau)*(eta*eta) -> mucho mas rapido
-                double p = (tau * tau) * (eta * eta); 
-                
-                candidatos.push_back(i);
-                probs.push_back(p);
-                sumProb += p;
+        // Con listas de candidatos: ruleta solo entre los vecinos cercanos no visitados
+        if (grafo.numCandidatos > 0) {
+            int k = grafo.numCandidatos;
+            const int* vecinos = grafo.candidatosDe(actual);
+            const RealACO* info = grafo.infoEleccion.data() + (size_t)actual * k;
+            double suma = 0.0;
+            for(int t=0; t<k; t++) {
+                suma += info[t] * libre(vecinos[t]);
+                acumulado[t] = suma;
             }
+            if (suma > 0) return vecinos[ruleta(acumulado, k)];
+            return mejorNoVisitado(actual, grafo); // Lista agotada: la mejor de las restantes
         }
         
-        // Ruleta
-        if (sumProb == 0) return candidatos[aleatorio(0, candidatos.size()-1)]; // Fallback raro
+        const RealACO* info = grafo.infoEleccion.data() + (size_t)actual * n;
+        double suma = 0.0;
+        for(int i=0; i<n; i++) {
+            suma += info[i] * libre(i);
+            acumulado[i] = suma;
+        }
+        if (suma > 0) return ruleta(acumulado, n);
         
-        double r = aleatorioUniforme() * sumProb;
-        double acumulado = 0.0;
-        for(size_t k=0; k<candidatos.size(); k++) {
-            acumulado += probs[k];
-            if (acumulado >= r) {
-                return candidatos[k];
+        // Fallback raro (todos los pesos nulos): uniforme entre los no visitados
+        int libres = 0;
+        for(int i=0; i<n; i++) libres += !estaVisitada(i);
+        int elegida = uniform_int_distribution<int>(0, libres - 1)(generador);
+        for(int i=0; i<n; i++) {
+            if (!estaVisitada(i) && elegida-- == 0) return i;
+        }
+        return -1;
+    }
+    
+    // argmax de tau^alpha * eta^beta entre los no visitados (candidatos si hay lista)
+    // -1 si todos los pesos son nulos: sigue la ruleta, que tiene sus propios fallbacks
+    int mejorPeso(int actual, const ACOGraph& grafo) {
+        int k = grafo.numCandidatos > 0 ? grafo.numCandidatos : n;
+        const int* vecinos = grafo.numCandidatos > 0 ? grafo.candidatosDe(actual) : nullptr;
+        const RealACO* info = grafo.infoEleccion.data() + (size_t)actual * k;
+        int mejor = -1;
+        double peso = 0.0;
+        for(int t=0; t<k; t++) {
+            double p = info[t] * libre(vecinos ? vecinos[t] : t);
+            if (p > peso) {
+                peso = p;
+                mejor = t;
             }
         }
+        if (mejor < 0) return -1;
+        return vecinos ? vecinos[mejor] : mejor;
+    }
+    
+    // Ciudad no visitada de mayor peso (solo al agotar la lista)
+    int mejorNoVisitado(int actual, const ACOGraph& grafo) {
+        // Modo disperso: fuera de las listas toda arista tiene la misma feromona y gana la más
+        // cercana (a igual distancia, la de menor índice); consulta al árbol, no recorrido O(n)
+        if (grafo.disperso) return grafo.arbol.masCercanaViva(libres, actual, 1);
         
-        return candidatos.back(); // Por error de redondeo
+        // Recorrido O(n): alpha se resuelve aquí una vez, no en cada arista
+        switch (grafo.alphaEntero()) {
+            case 0: return mejorNoVisitadoDenso<0>(actual, grafo);
+            case 1: return mejorNoVisitadoDenso<1>(actual, grafo);
+            case 2: return mejorNoVisitadoDenso<2>(actual, grafo);
+            case 3: return mejorNoVisitadoDenso<3>(actual, grafo);
+            case 4: return mejorNoVisitadoDenso<4>(actual, grafo);
+            case 5: return mejorNoVisitadoDenso<5>(actual, grafo);
+            case 6: return mejorNoVisitadoDenso<6>(actual, grafo);
+            default: return mejorNoVisitadoDenso<-1>(actual, grafo);
+        }
+    }
+    
+    template <int A>
+    int mejorNoVisitadoDenso(int actual, const ACOGraph& grafo) {
+        int mejor = -1;
+        double mejorPeso = -1.0;
+        for(int i=0; i<n; i++) {
+            if (estaVisitada(i)) continue;
+            double p = grafo.infoArista<A>(actual, i);
+            if (p > mejorPeso) {
+                mejorPeso = p;
+                mejor = i;
+            }
+        }
+        return mejor;
     }
 };
@@ -13,8 +13,7 @@ using namespace std;
 // Dominio: [-5.12, 5.12]
 // Mínimo Global: 0 en x=[0,0,...,0]
 
-double evaluadorRastrigin(const vector<double>& x) {
-    int d = x.size();
+double evaluadorRastrigin(const double* x, int d) {
     double sum = 0.0;
     
     for (int i = 0; i < d; i++) {
@@ -23,3 +22,7 @@ double evaluadorRastrigin(const vector<double>& x) {
     
     return 10.0 * d + sum;
 }
+
+double evaluadorRastrigin(const vector<double>& x) {
+    return evaluadorRastrigin(x.data(), x.size());
+}
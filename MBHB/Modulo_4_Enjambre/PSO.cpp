@@ -4,8 +4,15 @@
 #include <algorithm>
 #include <limits>
 #include <fstream>
+#include <cstring>
+#include <cstdint>
 #include "EvaluadorContinuo.cpp"
-// Asumimos Core/Generador.cpp incluido externamente para aleatorioUniforme()
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Asumimos Core/Generador.cpp incluido externamente para aleatorioUniforme() y rng
 
 using namespace std;
 
@@ -15,15 +22,104 @@ double aleatorioReal(double min, double max) {
     return min + (max - min) * aleatorioUniforme();
 }
 
-struct Particula {
+// Enjambre en Estructura de Arrays (SoA)
+// Posiciones, velocidades y pBest son bloques contiguos numParticulas x D (partícula i en
+// [i*D, (i+1)*D)), como los genotipos de PoblacionSoA: la actualización recorre memoria seguida
+// y el núcleo vectorial (moverParticula) no tiene que saltar entre vectores sueltos.
+struct EnjambreSoA {
+    int tam = 0; // Número de partículas
+    int dim = 0;
     vector<double> posicion;
     vector<double> velocidad;
-    
-    // Mejor Personal (pBest)
-    vector<double> pBestPos;
-    double pBestFit;
-    
-    double fitnessActual;
+    vector<double> pBestPos; // Mejor Personal (pBest)
+    vector<double> pBestFit;
+    vector<double> fitnessActual;
+
+    void inicializar(int numParticulas, int dimensiones) {
+        tam = numParticulas;
+        dim = dimensiones;
+        posicion.assign((size_t)tam * dim, 0.0);
+        velocidad.assign((size_t)tam * dim, 0.0);
+        pBestPos.assign((size_t)tam * dim, 0.0);
+        pBestFit.assign(tam, numeric_limits<double>::max());
+        fitnessActual.assign(tam, numeric_limits<double>::max());
+    }
+
+    double* posicionDe(int i) { return posicion.data() + (size_t)i * dim; }
+    double* velocidadDe(int i) { return velocidad.data() + (size_t)i * dim; }
+    double* pBestDe(int i) { return pBestPos.data() + (size_t)i * dim; }
+    const double* pBestDe(int i) const { return pBestPos.data() + (size_t)i * dim; }
+
+    void guardarPBest(int i) {
+        memcpy(pBestDe(i), posicionDe(i), sizeof(double) * dim);
+        pBestFit[i] = fitnessActual[i];
+    }
+};
+
+// Generador por lotes para r1/r2: xoshiro256+ en 4 flujos independientes (estado SoA, un carril
+// AVX2 por flujo). Cada llamada rellena un bloque múltiplo de 4 con reales en [0, 1) de 52 bits
+// (mantisa con exponente fijo menos 1, sin división). La ruta AVX2 y la escalar dan la misma secuencia.
+struct GeneradorLotes {
+    alignas(32) uint64_t s[4][4]; // s[palabra][flujo]
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    // Semilla sacada del generador global: mismo resultado para una misma inicializarSemilla
+    void sembrar() {
+        uint64_t x = ((uint64_t)rng() << 32) | rng();
+        for(int w = 0; w < 4; w++)
+            for(int f = 0; f < 4; f++) s[w][f] = splitmix64(x);
+    }
+
+    // num múltiplo de 4
+    void llenar(double* salida, size_t num) {
+        size_t i = 0;
+#if defined(__AVX2__)
+        __m256i s0 = _mm256_load_si256((const __m256i*)s[0]);
+        __m256i s1 = _mm256_load_si256((const __m256i*)s[1]);
+        __m256i s2 = _mm256_load_si256((const __m256i*)s[2]);
+        __m256i s3 = _mm256_load_si256((const __m256i*)s[3]);
+        const __m256i exponente = _mm256_set1_epi64x(0x3FF0000000000000ll);
+        const __m256d uno = _mm256_set1_pd(1.0);
+        for(; i + 4 <= num; i += 4) {
+            __m256i r = _mm256_add_epi64(s0, s3);
+            __m256i t = _mm256_slli_epi64(s1, 17);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+            __m256i bits = _mm256_or_si256(_mm256_srli_epi64(r, 12), exponente);
+            _mm256_storeu_pd(salida + i, _mm256_sub_pd(_mm256_castsi256_pd(bits), uno));
+        }
+        _mm256_store_si256((__m256i*)s[0], s0);
+        _mm256_store_si256((__m256i*)s[1], s1);
+        _mm256_store_si256((__m256i*)s[2], s2);
+        _mm256_store_si256((__m256i*)s[3], s3);
+#endif
+        for(; i + 4 <= num; i += 4) {
+            for(int f = 0; f < 4; f++) {
+                uint64_t r = s[0][f] + s[3][f];
+                uint64_t t = s[1][f] << 17;
+                s[2][f] ^= s[0][f];
+                s[3][f] ^= s[1][f];
+                s[1][f] ^= s[2][f];
+                s[0][f] ^= s[3][f];
+                s[2][f] ^= t;
+                s[3][f] = (s[3][f] << 45) | (s[3][f] >> 19);
+                uint64_t bits = (r >> 12) | 0x3FF0000000000000ull;
+                double u;
+                memcpy(&u, &bits, sizeof(u));
+                salida[i + f] = u - 1.0;
+            }
+        }
+    }
 };
 
 struct ConfigPSO {
@@ -51,21 +147,21 @@ struct ResultadoPSO {
 // Topología de Anillo (Vecindad local)
 // Retorna el índice de la mejor partícula en el vecindario de 'idx'
 // Vecinos: idx-2, idx-1, idx, idx+1, idx+2 (Circular)
-int obtenerLBestIndex(int idx, const vector<Particula>& enjambre) {
-    int n = enjambre.size();
+int obtenerLBestIndex(int idx, const vector<double>& pBestFit) {
+    int n = pBestFit.size();
     int mejorVecino = idx; // Incluye a sí misma? Guía dice "cada partícula tiene 4 vecinos". 
                            // Usualmente se compara con vecinos para hallar lBest.
                            // Asumiremos que lBest es el mejor de {i-2, i-1, i+1, i+2} (y tal vez i?).
                            // Standard PSO local: lBest es el mejor del vecindario.
     
-    // Indices relativos: -2, -1, 1, 2
-    vector<int> offsets = {-2, -1, 1, 2};
+    // Indices relativos: -2, -1, 1, 2 (tabla estática: sin reservar memoria por partícula e iteración)
+    static const int offsets[4] = {-2, -1, 1, 2};
     
     for (int off : offsets) {
         int vecinoIdx = (idx + off) % n;
         if (vecinoIdx < 0) vecinoIdx += n; // Corrección módulo negativo
         
-        if (enjambre[vecinoIdx].pBestFit < enjambre[mejorVecino].pBestFit) {
+        if (pBestFit[vecinoIdx] < pBestFit[mejorVecino]) {
             mejorVecino = vecinoIdx;
         }
     }
@@ -78,6 +174,41 @@ int obtenerLBestIndex(int idx, const vector<Particula>& enjambre) {
     return mejorVecino;
 }
 
+// Actualización de una partícula (D componentes):
+// V(t+1) = W*V(t) + c1*r1*(pBest - x) + c2*r2*(lBest - x);  X(t+1) = X(t) + V(t+1)
+// Control de Fronteras (Pared Absorbente): fuera de [minX, maxX] la posición queda en la pared y
+// la velocidad a 0. Sin ramas: min/max y una máscara, 4 componentes por instrucción con AVX2.
+// La cola escalar (o todo el recorrido sin AVX2) sigue la misma forma y el compilador la vectoriza.
+void moverParticula(double* x, double* v, const double* pBest, const double* lBest,
+                    const double* r1, const double* r2, int D, const ConfigPSO& config) {
+    int d = 0;
+#if defined(__AVX2__)
+    const __m256d W = _mm256_set1_pd(config.W);
+    const __m256d C1 = _mm256_set1_pd(config.C1);
+    const __m256d C2 = _mm256_set1_pd(config.C2);
+    const __m256d minX = _mm256_set1_pd(config.minX);
+    const __m256d maxX = _mm256_set1_pd(config.maxX);
+    for(; d + 4 <= D; d += 4) {
+        __m256d vx = _mm256_loadu_pd(x + d);
+        __m256d vv = _mm256_loadu_pd(v + d);
+        __m256d cognitivo = _mm256_mul_pd(_mm256_mul_pd(C1, _mm256_loadu_pd(r1 + d)), _mm256_sub_pd(_mm256_loadu_pd(pBest + d), vx));
+        __m256d social = _mm256_mul_pd(_mm256_mul_pd(C2, _mm256_loadu_pd(r2 + d)), _mm256_sub_pd(_mm256_loadu_pd(lBest + d), vx));
+        vv = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(W, vv), cognitivo), social);
+        vx = _mm256_add_pd(vx, vv);
+        __m256d fuera = _mm256_or_pd(_mm256_cmp_pd(vx, maxX, _CMP_GT_OQ), _mm256_cmp_pd(vx, minX, _CMP_LT_OQ));
+        _mm256_storeu_pd(x + d, _mm256_min_pd(_mm256_max_pd(vx, minX), maxX));
+        _mm256_storeu_pd(v + d, _mm256_andnot_pd(fuera, vv));
+    }
+#endif
+    for(; d < D; d++) {
+        double vd = config.W * v[d] + config.C1 * r1[d] * (pBest[d] - x[d]) + config.C2 * r2[d] * (lBest[d] - x[d]);
+        double xd = x[d] + vd;
+        bool fuera = xd > config.maxX || xd < config.minX;
+        x[d] = min(max(xd, config.minX), config.maxX);
+        v[d] = fuera ? 0.0 : vd;
+    }
+}
+
 ResultadoPSO ejecutarPSO(ConfigPSO config, string logFile = "") {
     ofstream log;
     if (logFile != "") {
@@ -85,81 +216,66 @@ ResultadoPSO ejecutarPSO(ConfigPSO config, string logFile = "") {
         log << "Iter,MejorGlobalFit\n";
     }
 
+    int N = config.numParticulas;
+    int D = config.dimensiones;
+
     // 1. Inicialización
-    vector<Particula> enjambre(config.numParticulas);
+    EnjambreSoA enjambre;
+    enjambre.inicializar(N, D);
     vector<double> mejorGlobalPos;
     double mejorGlobalFit = numeric_limits<double>::max();
     
-    for(int i=0; i<config.numParticulas; i++) {
-        enjambre[i].posicion.resize(config.dimensiones);
-        enjambre[i].velocidad.resize(config.dimensiones);
-        
-        for(int d=0; d<config.dimensiones; d++) {
-            enjambre[i].posicion[d] = aleatorioReal(config.minX, config.maxX);
-            enjambre[i].velocidad[d] = aleatorioReal(config.minV, config.maxV) * 0.1; // V inicial pequeña
+    for(int i=0; i<N; i++) {
+        double* x = enjambre.posicionDe(i);
+        double* v = enjambre.velocidadDe(i);
+        for(int d=0; d<D; d++) {
+            x[d] = aleatorioReal(config.minX, config.maxX);
+            v[d] = aleatorioReal(config.minV, config.maxV) * 0.1; // V inicial pequeña
         }
         
-        enjambre[i].fitnessActual = evaluadorRastrigin(enjambre[i].posicion);
+        enjambre.fitnessActual[i] = evaluadorRastrigin(x, D);
         
         // pBest inicial
-        enjambre[i].pBestPos = enjambre[i].posicion;
-        enjambre[i].pBestFit = enjambre[i].fitnessActual;
+        enjambre.guardarPBest(i);
         
         // gBest (solo para reporte, no para actualización en anillo estrictamente)
-        if (enjambre[i].pBestFit < mejorGlobalFit) {
-            mejorGlobalFit = enjambre[i].pBestFit;
-            mejorGlobalPos = enjambre[i].pBestPos;
+        if (enjambre.pBestFit[i] < mejorGlobalFit) {
+            mejorGlobalFit = enjambre.pBestFit[i];
+            mejorGlobalPos.assign(x, x + D);
         }
     }
     
+    // r1 y r2 de toda la iteración, generados de una vez: r1 de la partícula i en aleatorios[i*D..],
+    // r2 en aleatorios[N*D + i*D..]
+    GeneradorLotes generador;
+    generador.sembrar();
+    vector<double> aleatorios(((size_t)2 * N * D + 3) & ~(size_t)3);
+    
     // Bucle Principal
     for(int iter=0; iter<config.maxIteraciones; iter++) {
+        generador.llenar(aleatorios.data(), aleatorios.size());
         
-        for(int i=0; i<config.numParticulas; i++) {
+        for(int i=0; i<N; i++) {
             // 2. Determinar lBest (Local Best)
-            int lBestIdx = obtenerLBestIndex(i, enjambre);
-            const vector<double>& lBestPos = enjambre[lBestIdx].pBestPos;
+            int lBestIdx = obtenerLBestIndex(i, enjambre.pBestFit);
             
-            // 3. Actualizar Velocidad y Posición
-            for(int d=0; d<config.dimensiones; d++) {
-                double r1 = aleatorioUniforme();
-                double r2 = aleatorioUniforme();
-                
-                // V(t+1) = W*V(t) + c1*r1*(pBest - x) + c2*r2*(lBest - x)
-                enjambre[i].velocidad[d] = config.W * enjambre[i].velocidad[d] 
-                                         + config.C1 * r1 * (enjambre[i].pBestPos[d] - enjambre[i].posicion[d])
-                                         + config.C2 * r2 * (lBestPos[d] - enjambre[i].posicion[d]);
-                                         
-                // Control de Velocidad (Opcional, pero recomendado)
-                // if (enjambre[i].velocidad[d] > config.maxV) enjambre[i].velocidad[d] = config.maxV;
-                // if (enjambre[i].velocidad[d] < config.minV) enjambre[i].velocidad[d] = config.minV;
-                
-                // X(t+1) = X(t) + V(t+1)
-                enjambre[i].posicion[d] += enjambre[i].velocidad[d];
-                
-                // 4. Control de Fronteras (Pared Absorbente)
-                if (enjambre[i].posicion[d] > config.maxX) {
-                    enjambre[i].posicion[d] = config.maxX;
-                    enjambre[i].velocidad[d] = 0; // Choca y para
-                } else if (enjambre[i].posicion[d] < config.minX) {
-                    enjambre[i].posicion[d] = config.minX;
-                    enjambre[i].velocidad[d] = 0;
-                }
-            }
+            // 3-4. Actualizar Velocidad, Posición y Fronteras
+            double* x = enjambre.posicionDe(i);
+            moverParticula(x, enjambre.velocidadDe(i), enjambre.pBestDe(i), enjambre.pBestDe(lBestIdx),
+                           aleatorios.data() + (size_t)i * D, aleatorios.data() + (size_t)(N + i) * D, D, config);
             
             // 5. Evaluación y Actualización
-            double nuevoFit = evaluadorRastrigin(enjambre[i].posicion);
-            enjambre[i].fitnessActual = nuevoFit;
+            double nuevoFit = evaluadorRastrigin(x, D);
+            enjambre.fitnessActual[i] = nuevoFit;
             
             // Actualizar pBest
-            if (nuevoFit < enjambre[i].pBestFit) {
-                enjambre[i].pBestFit = nuevoFit;
-                enjambre[i].pBestPos = enjambre[i].posicion;
+            if (nuevoFit < enjambre.pBestFit[i]) {
+                enjambre.guardarPBest(i);
                 
                 // Actualizar gBest (Global)
                 if (nuevoFit < mejorGlobalFit) {
                     mejorGlobalFit = nuevoFit;
-                    mejorGlobalPos = enjambre[i].posicion;
+                    mejorGlobalPos.assign(x, x + D);
                 }
             }
         }
@@ -3,7 +3,17 @@
 #include <fstream>
 #include <cmath>
 #include <iostream>
-#include <sstream>
+#include <algorithm>
+#include <cstdint>
+#include <charconv>
+#include <string_view>
+#include <cctype>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 using namespace std;
 
@@ -13,9 +23,20 @@ struct Ciudad {
     double y;
 };
 
+// EDGE_WEIGHT_TYPE de TSPLIB soportados
+enum MetricaTSP {
+    METRICA_EUC_2D,   // Euclídea redondeada
+    METRICA_CEIL_2D,  // Euclídea redondeada hacia arriba
+    METRICA_ATT,      // Pseudo-euclídea (att48, att532)
+    METRICA_GEO,      // Geográfica: x, y son latitud y longitud en grados.minutos
+    METRICA_EXPLICITA // Matriz dada en EDGE_WEIGHT_SECTION
+};
+
 struct TSPInstance {
-    int n;
-    vector<Ciudad> ciudades;
+    int n = 0;
+    vector<Ciudad> ciudades;  // Vacío en EXPLICIT salvo que traiga DISPLAY_DATA_SECTION
+    MetricaTSP metrica = METRICA_EUC_2D;
+    vector<int> matriz;       // EXPLICIT: n x n completa y simétrica (cualquier formato se expande)
 };
 
 // Distancia Euclídea redondeada a entero (Estandar TSPLIB)
@@ -25,41 +46,452 @@ int distanciaEuc(const Ciudad& c1, const Ciudad& c2) {
     return (int)(round(sqrt(dx*dx + dy*dy)));
 }
 
-// Parser básico para formato TSPLIB (NODE_COORD_SECTION)
+// --- Métricas TSPLIB como funtores ---
+// Cada una se llama d(i, j) sobre índices de ciudad. Los bucles que recorren muchas aristas se
+// escriben una vez como lambda genérica y conDistancia los instancia para la métrica de la
+// instancia: un switch por bucle, no por distancia, y la distancia queda en línea.
+// 'monotona': la distancia es función creciente de la euclídea (desdeCuadrado(dx^2 + dy^2)), así
+// que el árbol k-d puede podar con ella.
+struct DistanciaEuc2D {
+    static const bool monotona = true;
+    const Ciudad* c;
+    static int desdeCuadrado(double d2) { return (int)(round(sqrt(d2))); } // Como distanciaEuc
+    int operator()(int i, int j) const {
+        double dx = c[i].x - c[j].x, dy = c[i].y - c[j].y;
+        return desdeCuadrado(dx*dx + dy*dy);
+    }
+};
+
+struct DistanciaCeil2D {
+    static const bool monotona = true;
+    const Ciudad* c;
+    static int desdeCuadrado(double d2) { return (int)(ceil(sqrt(d2))); }
+    int operator()(int i, int j) const {
+        double dx = c[i].x - c[j].x, dy = c[i].y - c[j].y;
+        return desdeCuadrado(dx*dx + dy*dy);
+    }
+};
+
+struct DistanciaAtt {
+    static const bool monotona = true;
+    const Ciudad* c;
+    static int desdeCuadrado(double d2) {
+        double r = sqrt(d2 / 10.0);
+        int t = (int)(r + 0.5);
+        return t < r ? t + 1 : t;
+    }
+    int operator()(int i, int j) const {
+        double dx = c[i].x - c[j].x, dy = c[i].y - c[j].y;
+        return desdeCuadrado(dx*dx + dy*dy);
+    }
+};
+
+// Fórmula de TSPLIB (radio 6378.388 km, PI = 3.141592, grados truncados)
+struct DistanciaGeo {
+    static const bool monotona = false;
+    const Ciudad* c;
+    static double radianes(double v) {
+        double grados = (int)v;
+        return 3.141592 * (grados + 5.0 * (v - grados) / 3.0) / 180.0;
+    }
+    int operator()(int i, int j) const {
+        double lat1 = radianes(c[i].x), lon1 = radianes(c[i].y);
+        double lat2 = radianes(c[j].x), lon2 = radianes(c[j].y);
+        double q1 = cos(lon1 - lon2), q2 = cos(lat1 - lat2), q3 = cos(lat1 + lat2);
+        return (int)(6378.388 * acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0);
+    }
+};
+
+struct DistanciaExplicita {
+    static const bool monotona = false;
+    const int* m;
+    int n;
+    int operator()(int i, int j) const { return m[(size_t)i * n + j]; }
+};
+
+bool metricaMonotona(MetricaTSP metrica) {
+    return metrica == METRICA_EUC_2D || metrica == METRICA_CEIL_2D || metrica == METRICA_ATT;
+}
+
+// Llama a f(d) con el funtor de la métrica de la instancia (f: lambda genérica)
+template <class F>
+void conDistancia(const TSPInstance& inst, F f) {
+    const Ciudad* c = inst.ciudades.data();
+    switch (inst.metrica) {
+        case METRICA_CEIL_2D: f(DistanciaCeil2D{c}); break;
+        case METRICA_ATT: f(DistanciaAtt{c}); break;
+        case METRICA_GEO: f(DistanciaGeo{c}); break;
+        case METRICA_EXPLICITA: f(DistanciaExplicita{inst.matriz.data(), inst.n}); break;
+        default: f(DistanciaEuc2D{c}); break;
+    }
+}
+
+// Distancia suelta (un switch por llamada): para bucles, conDistancia
+int distanciaTSP(const TSPInstance& inst, int i, int j) {
+    int d = 0;
+    conDistancia(inst, [&](auto dist) { d = dist(i, j); });
+    return d;
+}
+
+// --- Árbol k-d sobre las ciudades ---
+// Cada nodo cubre un tramo [ini, fin) de 'orden' y guarda su caja envolvente; se parte por la
+// mediana del lado más ancho hasta hojas de TAM_HOJA_KD ciudades. Las coordenadas se copian en
+// el orden de las hojas (px, py), así que el árbol no depende de la instancia tras construirlo.
+// Las consultas son exactas con la distancia TSPLIB (redondeada) y deshacen empates por índice,
+// igual que los recorridos O(n^2) a los que sustituyen: dan exactamente el mismo resultado.
+// 'distMin' eleva las distancias por debajo de ese valor (la visibilidad del ACO usa 1 para d = 0).
+// Poda con la métrica de la instancia si es monótona (EUC_2D, CEIL_2D, ATT). Con GEO o EXPLICIT
+// el árbol es una sola hoja con todas las ciudades: las consultas son el recorrido O(n) de siempre.
+// Guarda un puntero a la instancia, que debe vivir más que el árbol.
+const int TAM_HOJA_KD = 8;
+
+struct NodoKD {
+    double xmin, xmax, ymin, ymax;
+    int ini, fin;
+    int hijo;  // Hijo izquierdo (el derecho es hijo + 1); -1 en las hojas
+    int padre; // -1 en la raíz
+};
+
+struct ArbolKD;
+
+// Subconjunto de ciudades aún "vivas" para masCercanaViva (p.ej. las no visitadas)
+// Cada nodo cuenta sus vivas: borrar es O(profundidad) y las ramas vacías no se recorren.
+struct ConjuntoKD {
+    vector<int> vivas;     // Por nodo
+    vector<char> borrada;  // Por ciudad
+    void llenar(const ArbolKD& arbol);
+    void borrar(const ArbolKD& arbol, int ciudad);
+};
+
+struct ArbolKD {
+    int n = 0;
+    const TSPInstance* instancia = nullptr;
+    vector<NodoKD> nodos;
+    vector<int> orden;     // Ciudades en el orden de las hojas
+    vector<double> px, py; // Sus coordenadas, en ese mismo orden
+    vector<double> cx, cy; // Coordenadas por ciudad (puntos de consulta)
+    vector<int> hojaDe;
+
+    void construir(const TSPInstance& inst) {
+        instancia = &inst;
+        n = inst.n;
+        orden.resize(n);
+        nodos.clear();
+        hojaDe.assign(n, -1);
+        for(int i=0; i<n; i++) orden[i] = i;
+        if (!metricaMonotona(inst.metrica)) {
+            cx.clear(); cy.clear(); px.clear(); py.clear();
+            nodos.push_back({0, 0, 0, 0, 0, n, -1, -1});
+            hojaDe.assign(n, 0);
+            return;
+        }
+        cx.resize(n); cy.resize(n);
+        for(int i=0; i<n; i++) {
+            cx[i] = inst.ciudades[i].x;
+            cy[i] = inst.ciudades[i].y;
+        }
+        if (n == 0) return;
+        nodos.reserve(2 * (n / TAM_HOJA_KD + 1));
+        nodos.push_back({0, 0, 0, 0, 0, n, -1, -1});
+        dividir(0);
+        px.resize(n); py.resize(n);
+        for(int p=0; p<n; p++) {
+            px[p] = cx[orden[p]];
+            py[p] = cy[orden[p]];
+        }
+    }
+
+    // Los k más cercanos a la ciudad i (sin ella), de más cerca a más lejos; k <= n-1
+    // 'monticulo' es un buffer del llamador (pares distancia, ciudad)
+    void kVecinos(int i, int k, int* salida, vector<pair<int, int>>& monticulo, int distMin = 0) const {
+        monticulo.clear();
+        if (k > 0) conDistancia(*instancia, [&](auto d) { buscarK(0, i, k, distMin, monticulo, d); });
+        sort_heap(monticulo.begin(), monticulo.end());
+        for(int t=0; t<k; t++) salida[t] = monticulo[t].second;
+    }
+
+    // La viva más cercana a la ciudad i (i incluida si sigue viva); -1 si no queda ninguna.
+    // Si se pasa 'dist', se devuelve en ella su distancia
+    int masCercanaViva(const ConjuntoKD& vivas, int i, int distMin = 0, int* dist = nullptr) const {
+        pair<int, int> mejor = {INT32_MAX, -1};
+        if (n > 0 && vivas.vivas[0] > 0) conDistancia(*instancia, [&](auto d) { buscarViva(0, i, distMin, vivas, mejor, d); });
+        if (dist) *dist = mejor.first;
+        return mejor.second;
+    }
+
+private:
+    // Cota inferior de la distancia de i a cualquier ciudad del nodo (sin poda si no es monótona)
+    template <class D>
+    int cotaInferior(const NodoKD& nd, int i, int distMin) const {
+        if constexpr (D::monotona) {
+            double dx = max(0.0, max(nd.xmin - cx[i], cx[i] - nd.xmax));
+            double dy = max(0.0, max(nd.ymin - cy[i], cy[i] - nd.ymax));
+            return max(distMin, D::desdeCuadrado(dx*dx + dy*dy));
+        } else return distMin;
+    }
+
+    template <class D>
+    int distanciaHoja(int i, int p, int distMin, const D& d) const {
+        if constexpr (D::monotona) {
+            double dx = cx[i] - px[p];
+            double dy = cy[i] - py[p];
+            return max(distMin, D::desdeCuadrado(dx*dx + dy*dy));
+        } else return max(distMin, d(i, orden[p]));
+    }
+
+    void dividir(int nodo) {
+        int ini = nodos[nodo].ini, fin = nodos[nodo].fin;
+        double xmin = cx[orden[ini]], xmax = xmin, ymin = cy[orden[ini]], ymax = ymin;
+        for(int p=ini+1; p<fin; p++) {
+            int c = orden[p];
+            xmin = min(xmin, cx[c]); xmax = max(xmax, cx[c]);
+            ymin = min(ymin, cy[c]); ymax = max(ymax, cy[c]);
+        }
+        nodos[nodo].xmin = xmin; nodos[nodo].xmax = xmax;
+        nodos[nodo].ymin = ymin; nodos[nodo].ymax = ymax;
+        if (fin - ini <= TAM_HOJA_KD) {
+            for(int p=ini; p<fin; p++) hojaDe[orden[p]] = nodo;
+            return;
+        }
+        int mitad = ini + (fin - ini) / 2;
+        const vector<double>& eje = (xmax - xmin >= ymax - ymin) ? cx : cy;
+        nth_element(orden.begin() + ini, orden.begin() + mitad, orden.begin() + fin,
+                    [&](int a, int b) { return eje[a] < eje[b]; });
+        int hijo = nodos.size();
+        nodos[nodo].hijo = hijo;
+        nodos.push_back({0, 0, 0, 0, ini, mitad, -1, nodo});
+        nodos.push_back({0, 0, 0, 0, mitad, fin, -1, nodo});
+        dividir(hijo);
+        dividir(hijo + 1);
+    }
+
+    template <class D>
+    void buscarK(int nodo, int i, int k, int distMin, vector<pair<int, int>>& monticulo, const D& d) const {
+        const NodoKD& nd = nodos[nodo];
+        if ((int)monticulo.size() == k && cotaInferior<D>(nd, i, distMin) > monticulo.front().first) return;
+        if (nd.hijo == -1) {
+            for(int p=nd.ini; p<nd.fin; p++) {
+                int c = orden[p];
+                if (c == i) continue;
+                pair<int, int> clave = {distanciaHoja(i, p, distMin, d), c};
+                if ((int)monticulo.size() < k) {
+                    monticulo.push_back(clave);
+                    push_heap(monticulo.begin(), monticulo.end());
+                } else if (clave < monticulo.front()) {
+                    pop_heap(monticulo.begin(), monticulo.end());
+                    monticulo.back() = clave;
+                    push_heap(monticulo.begin(), monticulo.end());
+                }
+            }
+            return;
+        }
+        int a = nd.hijo, b = nd.hijo + 1;
+        if (cotaInferior<D>(nodos[b], i, distMin) < cotaInferior<D>(nodos[a], i, distMin)) swap(a, b);
+        buscarK(a, i, k, distMin, monticulo, d);
+        buscarK(b, i, k, distMin, monticulo, d);
+    }
+
+    template <class D>
+    void buscarViva(int nodo, int i, int distMin, const ConjuntoKD& vivas, pair<int, int>& mejor, const D& d) const {
+        const NodoKD& nd = nodos[nodo];
+        if (vivas.vivas[nodo] == 0 || cotaInferior<D>(nd, i, distMin) > mejor.first) return;
+        if (nd.hijo == -1) {
+            for(int p=nd.ini; p<nd.fin; p++) {
+                int c = orden[p];
+                if (vivas.borrada[c]) continue;
+                pair<int, int> clave = {distanciaHoja(i, p, distMin, d), c};
+                if (clave < mejor) mejor = clave;
+            }
+            return;
+        }
+        int a = nd.hijo, b = nd.hijo + 1;
+        if (cotaInferior<D>(nodos[b], i, distMin) < cotaInferior<D>(nodos[a], i, distMin)) swap(a, b);
+        buscarViva(a, i, distMin, vivas, mejor, d);
+        buscarViva(b, i, distMin, vivas, mejor, d);
+    }
+};
+
+void ConjuntoKD::llenar(const ArbolKD& arbol) {
+    vivas.resize(arbol.nodos.size());
+    for(size_t v=0; v<arbol.nodos.size(); v++) vivas[v] = arbol.nodos[v].fin - arbol.nodos[v].ini;
+    borrada.assign(arbol.n, 0);
+}
+
+void ConjuntoKD::borrar(const ArbolKD& arbol, int ciudad) {
+    if (borrada[ciudad]) return;
+    borrada[ciudad] = 1;
+    for(int v = arbol.hojaDe[ciudad]; v != -1; v = arbol.nodos[v].padre) vivas[v]--;
+}
+
+// --- Lectura TSPLIB ---
+// El fichero se proyecta en memoria (mmap; en Windows se lee entero a un string) y se recorre
+// con un cursor: la cabecera "CLAVE : valor" línea a línea y las secciones como un flujo de
+// números leídos con from_chars, sin copiar líneas ni pasar por stringstream.
+struct ArchivoTSP {
+    const char* datos = nullptr;
+    size_t tam = 0;
+#ifdef _WIN32
+    string contenido;
+    bool abrir(const string& ruta) {
+        ifstream f(ruta, ios::binary);
+        if (!f.is_open()) return false;
+        contenido.assign(istreambuf_iterator<char>(f), istreambuf_iterator<char>());
+        datos = contenido.data();
+        tam = contenido.size();
+        return true;
+    }
+#else
+    void* mapa = nullptr;
+    bool abrir(const string& ruta) {
+        int fd = open(ruta.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                mapa = m;
+                datos = (const char*)m;
+                tam = st.st_size;
+                madvise(m, tam, MADV_SEQUENTIAL);
+            }
+        }
+        close(fd);
+        return mapa != nullptr;
+    }
+    ~ArchivoTSP() { if (mapa) munmap(mapa, tam); }
+#endif
+};
+
+struct CursorTSP {
+    const char* p;
+    const char* fin;
+
+    void saltarBlancos() { while (p < fin && isspace((unsigned char)*p)) p++; }
+
+    bool leer(double& v) {
+        saltarBlancos();
+        auto r = from_chars(p, fin, v);
+        if (r.ec != errc()) return false;
+        p = r.ptr;
+        return true;
+    }
+
+    bool leer(int& v) {
+        saltarBlancos();
+        auto r = from_chars(p, fin, v);
+        if (r.ec != errc()) return false;
+        p = r.ptr;
+        return true;
+    }
+
+    // Siguiente línea no vacía partida en clave y valor (sin blancos en los extremos); false al acabar
+    bool cabecera(string_view& clave, string_view& valor) {
+        saltarBlancos();
+        if (p >= fin) return false;
+        const char* ini = p;
+        while (p < fin && *p != '\n') p++;
+        string_view linea(ini, p - ini);
+        size_t dosPuntos = linea.find(':');
+        clave = recortar(linea.substr(0, dosPuntos));
+        valor = dosPuntos == string_view::npos ? string_view() : recortar(linea.substr(dosPuntos + 1));
+        return true;
+    }
+
+    static string_view recortar(string_view t) {
+        while (!t.empty() && isspace((unsigned char)t.front())) t.remove_prefix(1);
+        while (!t.empty() && isspace((unsigned char)t.back())) t.remove_suffix(1);
+        return t;
+    }
+};
+
+// Lee n ciudades "id x y" (n = 0: hasta que deje de haber números)
+void leerCoordenadasTSP(CursorTSP& cursor, int n, vector<Ciudad>& ciudades) {
+    ciudades.clear();
+    if (n > 0) ciudades.reserve(n);
+    int id;
+    double x, y;
+    while ((n == 0 || (int)ciudades.size() < n) && cursor.leer(id) && cursor.leer(x) && cursor.leer(y)) {
+        ciudades.push_back({id, x, y});
+    }
+}
+
+// EDGE_WEIGHT_SECTION expandida a matriz n x n. Un formato por columnas recorre los mismos
+// pesos que el de filas del triángulo contrario (UPPER_COL = LOWER_ROW, ...). false si falta algo
+bool leerPesosTSP(CursorTSP& cursor, int n, string_view formato, vector<int>& matriz) {
+    bool completa = formato == "FULL_MATRIX", superior = false, diagonal = false;
+    if (formato == "UPPER_ROW" || formato == "LOWER_COL") superior = true;
+    else if (formato == "UPPER_DIAG_ROW" || formato == "LOWER_DIAG_COL") superior = diagonal = true;
+    else if (formato == "LOWER_DIAG_ROW" || formato == "UPPER_DIAG_COL") diagonal = true;
+    else if (!completa && formato != "LOWER_ROW" && formato != "UPPER_COL") {
+        cerr << "[TSP] EDGE_WEIGHT_FORMAT no soportado: " << formato << endl;
+        return false;
+    }
+    matriz.assign((size_t)n * n, 0);
+    double w;
+    for(int i=0; i<n; i++) {
+        // Columnas de la fila i
+        int desde = (completa || !superior) ? 0 : (diagonal ? i : i + 1);
+        int hasta = (completa || superior) ? n : (diagonal ? i + 1 : i);
+        for(int j = desde; j < hasta; j++) {
+            if (!cursor.leer(w)) return false;
+            matriz[(size_t)i * n + j] = (int)lround(w);
+            if (!completa) matriz[(size_t)j * n + i] = (int)lround(w);
+        }
+    }
+    return true;
+}
+
+// Parser TSPLIB: NODE_COORD_SECTION (EUC_2D, CEIL_2D, ATT, GEO) o EDGE_WEIGHT_SECTION (EXPLICIT:
+// FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW, LOWER_DIAG_ROW y sus equivalentes por
+// columnas); DISPLAY_DATA_SECTION da coordenadas a una EXPLICIT. n = 0 si no se puede leer.
 TSPInstance leerTSP(string ruta) {
     TSPInstance inst;
-    ifstream archivo(ruta);
-    string linea;
-    bool leyendoCoords = false;
-    
+    ArchivoTSP archivo;
     // Si no abre, retornamos vacía
-    if (!archivo.is_open()) {
-        inst.n = 0;
-        return inst; 
-    }
+    if (!archivo.abrir(ruta)) return inst;
 
-    while (getline(archivo, linea)) {
-        if (linea.find("DIMENSION") != string::npos) {
-            // Extraer N
-            size_t pos = linea.find(":");
-            inst.n = stoi(linea.substr(pos + 1));
-            inst.ciudades.reserve(inst.n);
+    CursorTSP cursor{archivo.datos, archivo.datos + archivo.tam};
+    string_view clave, valor, formato = "FULL_MATRIX";
+    bool pesosLeidos = false;
+    while (cursor.cabecera(clave, valor)) {
+        if (clave == "DIMENSION") {
+            from_chars(valor.data(), valor.data() + valor.size(), inst.n);
         }
-        else if (linea.find("NODE_COORD_SECTION") != string::npos) {
-            leyendoCoords = true;
-            continue;
+        else if (clave == "EDGE_WEIGHT_TYPE") {
+            if (valor == "EUC_2D") inst.metrica = METRICA_EUC_2D;
+            else if (valor == "CEIL_2D") inst.metrica = METRICA_CEIL_2D;
+            else if (valor == "ATT") inst.metrica = METRICA_ATT;
+            else if (valor == "GEO") inst.metrica = METRICA_GEO;
+            else if (valor == "EXPLICIT") inst.metrica = METRICA_EXPLICITA;
+            else {
+                cerr << "[TSP] EDGE_WEIGHT_TYPE no soportado: " << valor << endl;
+                return TSPInstance();
+            }
         }
-        else if (linea.find("EOF") != string::npos) {
-            break;
+        else if (clave == "EDGE_WEIGHT_FORMAT") {
+            formato = valor;
         }
-        else if (leyendoCoords) {
-            stringstream ss(linea);
-            int id; 
-            double x, y;
-            if (ss >> id >> x >> y) {
-                inst.ciudades.push_back({id, x, y});
-            }
+        else if (clave == "NODE_COORD_SECTION" || clave == "DISPLAY_DATA_SECTION") {
+            leerCoordenadasTSP(cursor, inst.n, inst.ciudades);
         }
+        else if (clave == "EDGE_WEIGHT_SECTION") {
+            if (inst.n <= 0 || !leerPesosTSP(cursor, inst.n, formato, inst.matriz)) return TSPInstance();
+            pesosLeidos = true;
+        }
+        else if (clave == "FIXED_EDGES_SECTION") {
+            int v;
+            while (cursor.leer(v) && v != -1) {}
+        }
+        else if (clave == "EOF") {
+            break;
+        }
+    }
+
+    if (inst.metrica == METRICA_EXPLICITA) {
+        if (!pesosLeidos) return TSPInstance();
+        if ((int)inst.ciudades.size() != inst.n) inst.ciudades.clear(); // Coordenadas solo si están todas
+    } else {
+        inst.n = inst.ciudades.size();
     }
     return inst;
 }
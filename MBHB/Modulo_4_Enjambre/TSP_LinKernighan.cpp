@@ -0,0 +1,218 @@
+#include <vector>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+// Lin-Kernighan encadenado para TSP
+// Cada movimiento LK es una cadena de intercambios 2-opt (flips): se quita (t1, t2), se añade
+// (t2, t3) con t3 vecino cercano de t2 y se quita (t3, t4), quedando (t1, t4) como arista de cierre.
+// Mientras la ganancia parcial sea positiva se sigue desde t4 (criterio de ganancia de LK), hasta
+// 'profundidad' intercambios, y se deshace hasta el mejor cierre de la cadena. Solo se prueban
+// otras alternativas si la cadena no mejora nada: 8 en el primer nivel, 5 en el segundo y 1 desde
+// ahí. Ninguna arista añadida se vuelve a quitar.
+// Las ciudades a revisar van en una cola con bits "no mirar", como en BusquedaLocalTSP.
+// Encadenado: tras el óptimo local se dan patadas double-bridge locales (tres tramos cortos
+// alrededor de una ciudad al azar) y se vuelve a optimizar desde sus extremos; si el tour
+// empeora se deshacen todos los intercambios desde la patada, así que nunca se copia el tour.
+// El tour es cualquier representación con la interfaz de TourArray (TSP_LocalSearch.cpp).
+// Asume incluidos antes ACO_Graph.cpp, Ant.cpp y TSP_LocalSearch.cpp.
+
+using namespace std;
+
+template <class Tour>
+struct LinKernighanTSP {
+    const ACOGraph* grafo = nullptr;
+    const int* vecinos = nullptr; // n x k, de más cerca a más lejos
+    int k = 0;
+    int profundidad = 50;          // Máximo de intercambios por movimiento
+    int anchura[2] = {8, 5};       // Alternativas en los niveles 1 y 2; desde el 3, solo la primera
+    int tramoPatada = 50;          // Longitud máxima de los tramos del double-bridge
+
+    Tour tour;
+    long long coste = 0;
+    vector<char> enCola;
+    vector<int> cola; // Circular: cada ciudad entra como mucho una vez
+    int cabeza = 0, numEnCola = 0;
+    vector<array<int, 4>> registro;  // Intercambios desde la última patada aceptada (para deshacer)
+    vector<pair<int, int>> anadidas; // Aristas añadidas por el movimiento en curso
+    mt19937 generador;
+    long long movimientos = 0, patadas = 0, patadasAceptadas = 0;
+    bool conLimite = false;                 // Hay tope de tiempo ('segundos' > 0)
+    chrono::steady_clock::time_point limite;
+
+    void preparar(const ACOGraph& g, const int* listaVecinos, int numVecinos) {
+        grafo = &g;
+        vecinos = listaVecinos;
+        k = numVecinos;
+    }
+
+    // Mejora sol (camino y coste) hasta óptimo LK y, si hay presupuesto, sigue con patadas hasta
+    // agotar 'segundos' o 'maxPatadas' (0 = sin ese límite; los dos a 0 = sin patadas).
+    // 'segundos' también corta el descenso inicial: en instancias grandes puede no llegar al óptimo.
+    // Las patadas usan su propio generador (semilla) para no depender del hilo que llama.
+    // Devuelve la ganancia
+    long long mejorar(SolucionTSP& sol, double segundos = 0, long long maxPatadas = 0, unsigned int semilla = 0) {
+        int n = sol.camino.size();
+        if (n < 5) return 0;
+        conLimite = segundos > 0;
+        limite = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(segundos));
+        tour.cargar(sol.camino);
+        coste = sol.coste;
+        enCola.assign(n, 1);
+        cola = sol.camino;
+        cabeza = 0;
+        numEnCola = n;
+        registro.clear();
+        optimoLocal();
+
+        long long mejorCoste = coste;
+        if ((segundos > 0 || maxPatadas > 0) && n >= 8) {
+            generador.seed(semilla);
+            for(long long p = 0; maxPatadas == 0 || p < maxPatadas; p++) {
+                if (fueraDeTiempo()) break;
+                registro.clear();
+                dobleBridge();
+                optimoLocal();
+                patadas++;
+                if (coste <= mejorCoste) {
+                    if (coste < mejorCoste) patadasAceptadas++;
+                    mejorCoste = coste;
+                } else {
+                    deshacerHasta(0);
+                    coste = mejorCoste;
+                }
+            }
+        }
+
+        tour.volcar(sol.camino);
+        long long ganancia = sol.coste - coste;
+        sol.coste = coste;
+        return ganancia;
+    }
+
+private:
+    // Distancia TSPLIB sin retocar (la de costeCamino): sol.coste de entrada y ganancias se miden igual
+    int d(int i, int j) const { return grafo->distancia(i, j); }
+
+    void encolar(int c) {
+        if (enCola[c]) return;
+        enCola[c] = 1;
+        int fin = cabeza + numEnCola;
+        if (fin >= (int)cola.size()) fin -= cola.size();
+        cola[fin] = c;
+        numEnCola++;
+    }
+
+    // Quita (p, q) y (r, s), añade (p, r) y (q, s): q y s van en el mismo sentido respecto a p y r.
+    // Se deshace con intercambio(p, r, q, s)
+    void intercambio(int p, int q, int r, int s) {
+        if (tour.siguiente(p) == q) tour.mover2opt(p, q, r, s);
+        else tour.mover2opt(q, p, s, r);
+    }
+
+    void aplicar(int p, int q, int r, int s) {
+        intercambio(p, q, r, s);
+        registro.push_back({p, q, r, s});
+    }
+
+    bool fueraDeTiempo() const { return conLimite && chrono::steady_clock::now() > limite; }
+
+    // Vacía la cola de ciudades a revisar. Con tope de tiempo se mira el reloj cada 256 ciudades
+    void optimoLocal() {
+        int n = tour.n;
+        for(int revisadas = 1; numEnCola > 0; revisadas++) {
+            if ((revisadas & 255) == 0 && fueraDeTiempo()) return;
+            int t1 = cola[cabeza];
+            if (++cabeza == n) cabeza = 0;
+            numEnCola--;
+            enCola[t1] = 0;
+
+            for(int sentido = 0; sentido < 2; sentido++) {
+                int t2 = sentido == 0 ? tour.siguiente(t1) : tour.anterior(t1);
+                size_t marca = registro.size();
+                anadidas.clear();
+                long long g = pasoLK(t1, t2, d(t1, t2), 0);
+                if (g > 0) {
+                    coste -= g;
+                    movimientos++;
+                    for(size_t i = marca; i < registro.size(); i++) {
+                        for(int c : registro[i]) encolar(c);
+                    }
+                    encolar(t1);
+                    break;
+                }
+            }
+        }
+    }
+
+    bool anadida(int a, int b) const {
+        for(auto& e : anadidas) {
+            if ((e.first == a && e.second == b) || (e.first == b && e.second == a)) return true;
+        }
+        return false;
+    }
+
+    // Tour actual con (t1, t2) adyacentes; 'g' = suma quitada - suma añadida, incluida (t1, t2).
+    // Sigue la cadena hasta 'profundidad' y se queda con el mejor cierre: devuelve su mejora
+    // (con sus intercambios aplicados) o 0 (todo deshecho)
+    long long pasoLK(int t1, int t2, long long g, int nivel) {
+        int alternativas = nivel < 2 ? anchura[nivel] : 1;
+        int sig2 = tour.siguiente(t2), ant2 = tour.anterior(t2); // Como conjunto, no cambian
+        const int* lista = vecinos + (size_t)t2 * k;
+        for(int v = 0; v < k && alternativas > 0; v++) {
+            int t3 = lista[v];
+            long long g1 = g - d(t2, t3);
+            if (g1 <= 0) break; // Vecinos ordenados: los siguientes tampoco cumplen
+            if (t3 == sig2 || t3 == ant2) continue;
+            // t4 en el mismo sentido que t1 respecto a t2 (un intento deshecho puede haber
+            // dejado el tour recorrido al revés)
+            int t4 = tour.siguiente(t2) == t1 ? tour.siguiente(t3) : tour.anterior(t3);
+            if (t4 == t1 || anadida(t3, t4)) continue;
+            alternativas--;
+
+            long long g2 = g1 + d(t3, t4);
+            aplicar(t2, t1, t3, t4);
+            anadidas.push_back({t2, t3});
+            size_t marca = registro.size();
+            long long cierre = g2 - d(t4, t1);
+            long long mejora = nivel + 1 < profundidad ? pasoLK(t1, t4, g2, nivel + 1) : 0;
+            if (mejora > 0 && mejora > cierre) return mejora;
+            deshacerHasta(marca); // Cerrar aquí es mejor que lo que haya más abajo
+            anadidas.resize(nivel + 1);
+            if (cierre > 0) return cierre;
+            anadidas.pop_back();
+            deshacerHasta(marca - 1);
+        }
+        return 0;
+    }
+
+    void deshacerHasta(size_t marca) {
+        while (registro.size() > marca) {
+            array<int, 4>& f = registro.back();
+            intercambio(f[0], f[2], f[1], f[3]);
+            registro.pop_back();
+        }
+    }
+
+    // Double-bridge local: a [b..c] [c1..e] f -> a [c1..e] [b..c] f, como tres intercambios
+    void dobleBridge() {
+        int n = tour.n;
+        int maxTramo = max(1, min(tramoPatada, (n - 2) / 2));
+        int a = generador() % n;
+        int l1 = 1 + generador() % maxTramo, l2 = 1 + generador() % maxTramo;
+        int b = tour.siguiente(a), c = b;
+        for(int i = 1; i < l1; i++) c = tour.siguiente(c);
+        int c1 = tour.siguiente(c), e = c1;
+        for(int i = 1; i < l2; i++) e = tour.siguiente(e);
+        int f = tour.siguiente(e);
+
+        coste += (long long)d(a, c1) + d(e, b) + d(c, f) - d(a, b) - d(c, c1) - d(e, f);
+        aplicar(a, b, e, f);                  // a [e..c1] [c..b] f
+        if (c1 != e) aplicar(a, e, c1, c);    // a [c1..e] [c..b] f
+        if (b != c) aplicar(e, c, b, f);      // a [c1..e] [b..c] f
+        for(int x : {a, b, c, c1, e, f}) encolar(x);
+    }
+};
+
+typedef MotorTourAuto<LinKernighanTSP> LinKernighanTSPAuto;
@@ -0,0 +1,463 @@
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+// Búsqueda Local para TSP: 2-opt y Or-opt con listas de vecinos y bits "no mirar"
+// Cada ciudad con el bit apagado está en una cola; al sacarla se prueban los movimientos que
+// añaden una arista entre ella y uno de sus vecinos más cercanos (la lista está ordenada por
+// distancia: en cuanto la arista nueva ya no es más corta que la que se quita, se corta).
+// Si nada mejora se enciende su bit; si un movimiento mejora, los extremos de las aristas
+// tocadas vuelven a la cola. Primera mejora, hasta óptimo local respecto a las listas.
+// El tour es un parámetro de plantilla con la interfaz de TourArray (n, cargar, volcar, siguiente,
+// anterior, entre, mover2opt): TourArray para instancias pequeñas y medianas, TourDosNiveles para
+// las grandes.
+// Asume incluidos antes ACO_Graph.cpp (distancia, vecinosMasCercanos) y Ant.cpp (SolucionTSP).
+
+using namespace std;
+
+// Tour como array de ciudades + posición de cada ciudad
+// mover2opt invierte el tramo más corto de los dos posibles: O(n) en el peor caso.
+struct TourArray {
+    int n = 0;
+    vector<int> ciudad; // ciudad[p]: ciudad en la posición p
+    vector<int> pos;    // pos[c]: posición de la ciudad c
+
+    void cargar(const vector<int>& camino) {
+        n = camino.size();
+        ciudad = camino;
+        pos.resize(n);
+        for(int p=0; p<n; p++) pos[ciudad[p]] = p;
+    }
+
+    void volcar(vector<int>& camino) const { camino = ciudad; }
+
+    int siguiente(int c) const { int p = pos[c] + 1; return ciudad[p == n ? 0 : p]; }
+    int anterior(int c) const { int p = pos[c] - 1; return ciudad[p < 0 ? n - 1 : p]; }
+
+    // ¿Está b en el camino a -> c (en el sentido de avance, extremos incluidos)?
+    bool entre(int a, int b, int c) const {
+        int pa = pos[a], pb = pos[b], pc = pos[c];
+        if (pa <= pc) return pa <= pb && pb <= pc;
+        return pb >= pa || pb <= pc;
+    }
+
+    // 2-opt: quita (a, b) y (c, d), con b = siguiente(a) y d = siguiente(c), y añade (a, c) y (b, d)
+    // Invertir b..c o d..a da el mismo ciclo; se invierte el más corto (el sentido puede cambiar)
+    void mover2opt(int a, int b, int c, int d) {
+        int i = pos[b], j = pos[c];
+        int len = j - i + 1;
+        if (len <= 0) len += n;
+        if (2 * len > n) {
+            i = pos[d];
+            j = pos[a];
+            len = n - len;
+        }
+        for(int k=0; k<len/2; k++) {
+            int ci = ciudad[i], cj = ciudad[j];
+            ciudad[i] = cj; pos[cj] = i;
+            ciudad[j] = ci; pos[ci] = j;
+            if (++i == n) i = 0;
+            if (--j < 0) j = n - 1;
+        }
+    }
+};
+
+// Tour como lista doblemente enlazada de dos niveles (Fredman et al.)
+// Las ciudades se reparten en ~sqrt(n) segmentos consecutivos. Cada segmento guarda sus extremos,
+// su posición en el anillo de segmentos y un bit de inversión; cada ciudad, su segmento, su índice
+// y sus vecinas dentro del segmento (en orden almacenado). siguiente/anterior/entre son O(1).
+// Invertir un camino: se corta en sus extremos (la parte más pequeña del segmento cortado pasa al
+// segmento vecino) y se invierte el tramo de segmentos enteros cambiando bits y enlaces del anillo,
+// O(sqrt(n)); si el camino cae dentro de un segmento se invierte ahí mismo. Si un segmento crece
+// demasiado a base de recibir partes, se reparte todo de nuevo (O(n), raro).
+struct TourDosNiveles {
+    int n = 0;
+    int grupo = 0;  // Tamaño nominal de segmento
+    int numSeg = 0;
+    // Por ciudad
+    vector<int> padre, idx, sigC, antC; // sigC/antC: en orden almacenado, -1 en los extremos del segmento
+    // Por segmento
+    vector<int> primero, ultimo;        // Extremos en orden almacenado
+    vector<int> rango, sigSeg, antSeg;  // Anillo de segmentos en el sentido del tour
+    vector<int> tam;
+    vector<char> inv;
+    vector<int> buffer;
+    bool desequilibrado = false;
+
+    void cargar(const vector<int>& camino) {
+        n = camino.size();
+        numSeg = max(2, (int)sqrt((double)n));
+        grupo = (n + numSeg - 1) / numSeg;
+        padre.resize(n); idx.resize(n); sigC.resize(n); antC.resize(n);
+        primero.resize(numSeg); ultimo.resize(numSeg); rango.resize(numSeg);
+        sigSeg.resize(numSeg); antSeg.resize(numSeg); tam.resize(numSeg); inv.assign(numSeg, 0);
+        for(int s=0; s<numSeg; s++) {
+            int ini = (int)((long long)s * n / numSeg), fin = (int)((long long)(s + 1) * n / numSeg);
+            primero[s] = camino[ini];
+            ultimo[s] = camino[fin - 1];
+            rango[s] = s;
+            sigSeg[s] = (s + 1) % numSeg;
+            antSeg[s] = (s + numSeg - 1) % numSeg;
+            tam[s] = fin - ini;
+            for(int p=ini; p<fin; p++) {
+                int c = camino[p];
+                padre[c] = s;
+                idx[c] = p - ini;
+                sigC[c] = (p + 1 < fin) ? camino[p + 1] : -1;
+                antC[c] = (p > ini) ? camino[p - 1] : -1;
+            }
+        }
+        desequilibrado = false;
+    }
+
+    void volcar(vector<int>& camino) const {
+        camino.resize(n);
+        int c = primeroTour(0);
+        for(int p=0; p<n; p++) {
+            camino[p] = c;
+            c = siguiente(c);
+        }
+    }
+
+    int primeroTour(int s) const { return inv[s] ? ultimo[s] : primero[s]; }
+    int ultimoTour(int s) const { return inv[s] ? primero[s] : ultimo[s]; }
+
+    int siguiente(int c) const {
+        int s = padre[c];
+        if (!inv[s]) { if (c != ultimo[s]) return sigC[c]; }
+        else if (c != primero[s]) return antC[c];
+        return primeroTour(sigSeg[s]);
+    }
+
+    int anterior(int c) const {
+        int s = padre[c];
+        if (!inv[s]) { if (c != primero[s]) return antC[c]; }
+        else if (c != ultimo[s]) return sigC[c];
+        return ultimoTour(antSeg[s]);
+    }
+
+    // Orden dentro del segmento en el sentido del tour
+    int clave(int c) const { return inv[padre[c]] ? -idx[c] : idx[c]; }
+
+    // Posición lineal comparable: (rango del segmento, clave)
+    bool antes(int a, int b) const {
+        int ra = rango[padre[a]], rb = rango[padre[b]];
+        return ra != rb ? ra < rb : clave(a) < clave(b);
+    }
+
+    bool entre(int a, int b, int c) const {
+        if (!antes(c, a)) return !antes(b, a) && !antes(c, b); // a <= b <= c
+        return !antes(b, a) || !antes(c, b);
+    }
+
+    // 2-opt: quita (a, b) y (c, d), con b = siguiente(a) y d = siguiente(c), y añade (a, c) y (b, d)
+    // Se invierte b..c o d..a, el que abarque menos segmentos
+    void mover2opt(int a, int b, int c, int d) {
+        int k1 = (rango[padre[c]] - rango[padre[b]] + numSeg) % numSeg;
+        int k2 = (rango[padre[a]] - rango[padre[d]] + numSeg) % numSeg;
+        if (k1 <= k2) invertirCamino(b, c);
+        else invertirCamino(d, a);
+        if (desequilibrado) {
+            vector<int> camino;
+            volcar(camino);
+            cargar(camino);
+        }
+    }
+
+private:
+    // Invierte el camino x..y (sentido del tour)
+    void invertirCamino(int x, int y) {
+        if (padre[x] == padre[y] && clave(x) <= clave(y)) { invertirDentro(x, y); return; }
+        cortarAntes(x, -1);
+        if (padre[x] == padre[y]) { invertirDentro(x, y); return; } // x ya es el primero
+        int z = siguiente(y);
+        if (padre[z] == padre[y]) cortarAntes(z, padre[x]); // Sin tocar el segmento que empieza en x
+
+        // Tramo de segmentos enteros padre[x] .. padre[y]: invertir su orden y sus bits
+        int sx = padre[x], sy = padre[y];
+        int previo = antSeg[sx], posterior = sigSeg[sy];
+        buffer.clear();
+        for(int s = sx; ; s = sigSeg[s]) {
+            buffer.push_back(s);
+            if (s == sy) break;
+        }
+        int k = buffer.size();
+        for(int i=0; i<k/2; i++) {
+            int r = rango[buffer[i]];
+            rango[buffer[i]] = rango[buffer[k - 1 - i]];
+            rango[buffer[k - 1 - i]] = r;
+        }
+        for(int s : buffer) {
+            inv[s] ^= 1;
+            swap(sigSeg[s], antSeg[s]);
+        }
+        sigSeg[previo] = sy; antSeg[sy] = previo;
+        antSeg[posterior] = sx; sigSeg[sx] = posterior;
+    }
+
+    // Invierte x..y dentro de su segmento (clave(x) <= clave(y)), O(longitud)
+    void invertirDentro(int x, int y) {
+        int s = padre[x];
+        int u = inv[s] ? y : x, v = inv[s] ? x : y; // Orden almacenado u..v
+        int pu = antC[u], nv = sigC[v];
+        buffer.clear();
+        for(int c = u; ; c = sigC[c]) {
+            buffer.push_back(c);
+            if (c == v) break;
+        }
+        int L = buffer.size();
+        int idx0 = idx[u];
+        for(int i=0; i<L; i++) {
+            int c = buffer[L - 1 - i];
+            idx[c] = idx0 + i;
+            antC[c] = (i == 0) ? pu : buffer[L - i];
+            sigC[c] = (i == L - 1) ? nv : buffer[L - 2 - i];
+        }
+        if (pu == -1) primero[s] = v; else sigC[pu] = v;
+        if (nv == -1) ultimo[s] = u; else antC[nv] = u;
+    }
+
+    // Deja a x como primera ciudad (sentido del tour) de su segmento. La parte menor pasa al
+    // segmento vecino: la anterior a x al segmento previo, o x y lo que sigue al siguiente
+    // (salvo que este sea 'prohibido').
+    void cortarAntes(int x, int prohibido) {
+        int s = padre[x];
+        int cabeza = primeroTour(s);
+        if (x == cabeza) return;
+        int numAntes = abs(idx[x] - idx[cabeza]);
+        int numDesde = tam[s] - numAntes;
+        bool moverDesde = numDesde < numAntes && sigSeg[s] != prohibido;
+
+        if (!moverDesde) {
+            // [cabeza .. anterior(x)] al final (sentido del tour) del segmento previo
+            int t = antSeg[s];
+            for(int c = cabeza; c != x; ) {
+                int sig = siguiente(c);
+                anadirAlFinal(t, c);
+                c = sig;
+            }
+            if (!inv[s]) { primero[s] = x; antC[x] = -1; }
+            else { ultimo[s] = x; sigC[x] = -1; }
+            tam[s] -= numAntes;
+        } else {
+            // [x .. final] al principio (sentido del tour) del segmento siguiente, desde el final
+            int t = sigSeg[s];
+            int previo = anterior(x);
+            for(int c = ultimoTour(s); ; ) {
+                int ant = anterior(c);
+                anadirAlPrincipio(t, c);
+                if (c == x) break;
+                c = ant;
+            }
+            if (!inv[s]) { ultimo[s] = previo; sigC[previo] = -1; }
+            else { primero[s] = previo; antC[previo] = -1; }
+            tam[s] -= numDesde;
+        }
+    }
+
+    void anadirAlFinal(int t, int c) {
+        padre[c] = t;
+        if (!inv[t]) {
+            int u = ultimo[t];
+            idx[c] = idx[u] + 1; antC[c] = u; sigC[c] = -1; sigC[u] = c; ultimo[t] = c;
+        } else {
+            int u = primero[t];
+            idx[c] = idx[u] - 1; sigC[c] = u; antC[c] = -1; antC[u] = c; primero[t] = c;
+        }
+        if (++tam[t] > 4 * grupo) desequilibrado = true;
+    }
+
+    void anadirAlPrincipio(int t, int c) {
+        padre[c] = t;
+        if (!inv[t]) {
+            int u = primero[t];
+            idx[c] = idx[u] - 1; sigC[c] = u; antC[c] = -1; antC[u] = c; primero[t] = c;
+        } else {
+            int u = ultimo[t];
+            idx[c] = idx[u] + 1; antC[c] = u; sigC[c] = -1; sigC[u] = c; ultimo[t] = c;
+        }
+        if (++tam[t] > 4 * grupo) desequilibrado = true;
+    }
+};
+
+template <class Tour>
+struct BusquedaLocalTSP {
+    const ACOGraph* grafo = nullptr;
+    const int* vecinos = nullptr; // n x k, de más cerca a más lejos
+    int k = 0;
+    bool usarOrOpt = true;
+
+    Tour tour;
+    vector<char> enCola;
+    vector<int> cola; // Circular: cada ciudad entra como mucho una vez
+    int cabeza = 0, numEnCola = 0;
+    long long movimientos = 0;
+
+    void preparar(const ACOGraph& g, const int* listaVecinos, int numVecinos) {
+        grafo = &g;
+        vecinos = listaVecinos;
+        k = numVecinos;
+    }
+
+    // Mejora sol (camino y coste) hasta óptimo local; devuelve la ganancia
+    long long mejorar(SolucionTSP& sol) {
+        int n = sol.camino.size();
+        if (n < 5) return 0;
+        tour.cargar(sol.camino);
+        enCola.assign(n, 1);
+        cola = sol.camino; // Todas, en orden de recorrido
+        cabeza = 0;
+        numEnCola = n;
+
+        long long ganancia = 0;
+        while (numEnCola > 0) {
+            int a = cola[cabeza];
+            if (++cabeza == n) cabeza = 0;
+            numEnCola--;
+            enCola[a] = 0;
+
+            long long g = mejorar2opt(a);
+            if (g == 0 && usarOrOpt) g = mejorarOrOpt(a);
+            if (g > 0) {
+                ganancia += g;
+                movimientos++;
+                encolar(a); // Puede haber más mejoras desde la misma ciudad
+            }
+        }
+
+        tour.volcar(sol.camino);
+        sol.coste -= ganancia;
+        return ganancia;
+    }
+
+private:
+    int d(int i, int j) const { return grafo->distancia(i, j); }
+
+    void encolar(int c) {
+        if (enCola[c]) return;
+        enCola[c] = 1;
+        int fin = cabeza + numEnCola;
+        if (fin >= (int)cola.size()) fin -= cola.size();
+        cola[fin] = c;
+        numEnCola++;
+    }
+
+    // 2-opt sobre (a, b) y (c, e) en el sentido que tengan ahora: la representación puede
+    // haber invertido el otro tramo en un movimiento anterior
+    void aplicar2opt(int a, int b, int c, int e) {
+        if (tour.siguiente(a) == b) tour.mover2opt(a, b, c, e);
+        else tour.mover2opt(b, a, e, c);
+        encolar(a); encolar(b); encolar(c); encolar(e);
+    }
+
+    // Arista nueva (a, c) con c vecino de a, en los dos sentidos del recorrido
+    long long mejorar2opt(int a) {
+        const int* va = vecinos + (size_t)a * k;
+        for(int sentido=0; sentido<2; sentido++) {
+            int a2 = sentido == 0 ? tour.siguiente(a) : tour.anterior(a);
+            int dA = d(a, a2);
+            for(int t=0; t<k; t++) {
+                int c = va[t];
+                int dAC = d(a, c);
+                if (dAC >= dA) break; // Ni la primera arista nueva mejora a la quitada
+                int c2 = sentido == 0 ? tour.siguiente(c) : tour.anterior(c);
+                if (c == a2 || c2 == a) continue;
+                long long delta = (long long)dAC + d(a2, c2) - dA - d(c, c2);
+                if (delta < 0) {
+                    if (sentido == 0) aplicar2opt(a, a2, c, c2);
+                    else aplicar2opt(a2, a, c2, c);
+                    return -delta;
+                }
+            }
+        }
+        return 0;
+    }
+
+    // Or-opt: mover un tramo de 1 a 3 ciudades que empieza o acaba en a entre dos ciudades
+    // vecinas, en cualquiera de las dos orientaciones
+    long long mejorarOrOpt(int a) {
+        int n = tour.n;
+        for(int L=1; L<=3 && L+3<=n; L++) {
+            for(int sentido=0; sentido<2; sentido++) {
+                // Tramo s1..s2 en el sentido de avance
+                int otro = a;
+                for(int i=1; i<L; i++) otro = sentido == 0 ? tour.siguiente(otro) : tour.anterior(otro);
+                int s1 = sentido == 0 ? a : otro;
+                int s2 = sentido == 0 ? otro : a;
+                int p = tour.anterior(s1), nx = tour.siguiente(s2);
+                long long gQuitar = (long long)d(p, s1) + d(s2, nx) - d(p, nx);
+                if (gQuitar <= 0) continue;
+
+                for(int extremo=0; extremo<2; extremo++) {
+                    int s = extremo == 0 ? s1 : s2;
+                    const int* vs = vecinos + (size_t)s * k;
+                    for(int t=0; t<k; t++) {
+                        int c = vs[t];
+                        if (d(s, c) >= gQuitar) break;
+                        if (enTramo(c, s1, L)) continue;
+                        // Arista de inserción (c, siguiente) o (anterior, c)
+                        for(int lado=0; lado<2; lado++) {
+                            int e1 = lado == 0 ? c : tour.anterior(c);
+                            int e2 = tour.siguiente(e1);
+                            long long g = insertarTramo(s1, s2, L, p, nx, e1, e2, gQuitar);
+                            if (g > 0) return g;
+                        }
+                    }
+                }
+            }
+        }
+        return 0;
+    }
+
+    bool enTramo(int c, int s1, int L) const {
+        int x = s1;
+        for(int i=0; i<L; i++) {
+            if (x == c) return true;
+            x = tour.siguiente(x);
+        }
+        return false;
+    }
+
+    // Lleva s1..s2 (entre p y nx) a la arista (e1, e2), e2 = siguiente(e1), si mejora
+    // Con 2-opt encadenados: p S nx X e1 e2 -> p e1..nx S' e2 -> p nx..e1 S' e2 (S invertido)
+    // y, si conviene la orientación original, un tercero invierte S
+    long long insertarTramo(int s1, int s2, int L, int p, int nx, int e1, int e2, long long gQuitar) {
+        if (e1 == p || e2 == p || enTramo(e1, s1, L)) return 0;
+        long long dE = d(e1, e2);
+        long long costeInv = (long long)d(e1, s2) + d(s1, e2) - dE; // e1 s2..s1 e2
+        long long costeDir = (long long)d(e1, s1) + d(s2, e2) - dE; // e1 s1..s2 e2
+        bool directo = L > 1 && costeDir < costeInv;
+        long long g = gQuitar - (directo ? costeDir : costeInv);
+        if (g <= 0) return 0;
+
+        aplicar2opt(p, s1, e1, e2);
+        if (e1 != nx) aplicar2opt(p, e1, nx, s2);
+        if (directo) aplicar2opt(e1, s2, s1, e2);
+        return g;
+    }
+};
+
+// Motor de mejora (BusquedaLocalTSP, LinKernighanTSP) con la representación elegida por tamaño:
+// array hasta 'umbralDosNiveles' ciudades, lista de dos niveles desde ahí (0 = siempre array).
+// Con tours poco ordenados, como los de las hormigas, las inversiones son largas: a n = 30000 el
+// array tarda ~7 veces más en el 2-opt.
+template <template <class> class Motor>
+struct MotorTourAuto {
+    bool dosNiveles = false;
+    Motor<TourArray> conArray;
+    Motor<TourDosNiveles> conLista;
+
+    void preparar(const ACOGraph& g, const int* listaVecinos, int numVecinos, int umbralDosNiveles) {
+        dosNiveles = umbralDosNiveles > 0 && g.n >= umbralDosNiveles;
+        conArray.preparar(g, listaVecinos, numVecinos);
+        conLista.preparar(g, listaVecinos, numVecinos);
+    }
+
+    template <class... Args>
+    long long mejorar(SolucionTSP& sol, Args... args) {
+        return dosNiveles ? conLista.mejorar(sol, args...) : conArray.mejorar(sol, args...);
+    }
+};
+
+typedef MotorTourAuto<BusquedaLocalTSP> BusquedaLocalTSPAuto;
@@ -0,0 +1,76 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <iomanip>
+#include <chrono>
+#include <numeric>
+
+// Includes - Unity Build Style
+#include "Core/Generador.cpp"
+#include "Core/EspacioTrabajo.cpp"
+#include "Modulo_3_Evolutivos/Crossover.cpp"
+
+using namespace std;
+
+// Microbenchmark de operadores de cruce: ns por hijo generado
+// Compilar con -O3 (y -march=native para comparar con la máquina de experimentos).
+// Los padres se toman de un banco fijo de permutaciones para que los datos estén en caché,
+// como en una población de AGG/CHC: se mide el operador, no la memoria.
+
+const int BANCO = 64;
+
+bool esPermutacion(const int* sol, int n, vector<int>& cuenta) {
+    fill(cuenta.begin(), cuenta.end(), 0);
+    for(int i=0; i<n; i++) {
+        if (sol[i] < 0 || sol[i] >= n || cuenta[sol[i]]++) return false;
+    }
+    return true;
+}
+
+void benchCruce(OperadorCruce op, int n) {
+    vector<vector<int>> padres(BANCO, vector<int>(n));
+    for(auto& p : padres) {
+        iota(p.begin(), p.end(), 0);
+        shuffle(p.begin(), p.end(), rng);
+    }
+    vector<int> h1(n), h2(n), cuenta(n);
+    EspacioTrabajo ws;
+    ws.reservar(n);
+    
+    // Validación rápida antes de medir
+    for(int i=0; i<BANCO; i++) {
+        cruzar(op, padres[i].data(), padres[(i + 1) % BANCO].data(), h1.data(), h2.data(), n, ws);
+        if (!esPermutacion(h1.data(), n, cuenta) || !esPermutacion(h2.data(), n, cuenta)) {
+            cout << "[ERROR] " << nombreCruce(op) << " genera un hijo no valido (n=" << n << ")\n";
+            return;
+        }
+    }
+    
+    // ~2*10^7 genes escritos por medida: suficiente para tiempos estables en cualquier n
+    int llamadas = max(10000, 10000000 / n);
+    long long checksum = 0;
+    auto inicio = chrono::steady_clock::now();
+    for(int k=0; k<llamadas; k++) {
+        int i = k & (BANCO - 1);
+        cruzar(op, padres[i].data(), padres[(i + 7) & (BANCO - 1)].data(), h1.data(), h2.data(), n, ws);
+        checksum += h1[k % n] + h2[0]; // Evita que el compilador elimine el trabajo
+    }
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    double nsPorHijo = segundos * 1e9 / (2.0 * llamadas);
+    
+    cout << left << setw(10) << nombreCruce(op) << setw(8) << n << setw(15) << fixed << setprecision(1) << nsPorHijo
+         << setw(15) << setprecision(2) << nsPorHijo / n << (checksum == -1 ? "*" : "") << endl;
+}
+
+int main() {
+    cout << "MICROBENCHMARK CRUCES (ns por hijo)\n";
+    inicializarSemilla(123456);
+    cout << left << setw(10) << "Cruce" << setw(8) << "n" << setw(15) << "ns/hijo" << setw(15) << "ns/gen" << endl;
+    cout << "------------------------------------------------" << endl;
+    
+    vector<OperadorCruce> operadores = {CRUCE_OX, CRUCE_PMX, CRUCE_CX, CRUCE_POSICION};
+    for(int n : {25, 50, 100, 256}) {
+        for(OperadorCruce op : operadores) benchCruce(op, n);
+    }
+    return 0;
+}
@@ -7,6 +7,7 @@
 
 // Modules
 #include "Core/Generador.cpp"
+#include "Core/EspacioTrabajo.cpp"
 #include "Core/Lecture.cpp"
 #include "Core/Evaluador.cpp"
 #include "Modulo_1_Trayectorias/Greedy.cpp"
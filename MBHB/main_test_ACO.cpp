@@ -2,6 +2,8 @@
 #include <vector>
 #include <string>
 #include "Core/Generador.cpp"
+#include "Core/EspacioTrabajo.cpp"
+#include "Core/Paralelo.cpp"
 #include "Modulo_4_Enjambre/ACO.cpp"
 
 using namespace std;
@@ -22,6 +24,362 @@ void generarDummyTSP(string filename, int n) {
     f.close();
 }
 
+// Comparativa rápida con el mismo tiempo: recorrido completo frente a listas de candidatos
+void compararCandidatos(const TSPInstance& inst, double segundos) {
+    cout << "\n--- Comparativa construccion (" << segundos << "s cada una): lista completa vs candidatos ---\n";
+    vector<int> tamLista = {0, 20};
+    vector<ResultadoACO> resultados;
+    for(int k : tamLista) {
+        ConfigACO config;
+        config.numCandidatos = k;
+        config.timeLimitSec = segundos;
+        inicializarSemilla(123);
+        resultados.push_back(ejecutarACO(inst, VarianteACO::ELITISTA, "", config));
+    }
+    for(size_t i=0; i<tamLista.size(); i++) {
+        cout << "Candidatos=" << tamLista[i] << (tamLista[i] == 0 ? " (todas)" : "")
+             << "  Tours: " << resultados[i].evaluaciones << "  Mejor: " << resultados[i].mejorSolucion.coste << endl;
+    }
+}
+
+// Mismo número de iteraciones con 1 y con 4 hilos: la colonia debe dar el mismo resultado
+void comprobarDeterminismo(const TSPInstance& inst) {
+    cout << "\n--- Determinismo de la colonia paralela (200 iteraciones) ---\n";
+    long long costes[2];
+    int hilos[2] = {1, 4};
+    for(int h=0; h<2; h++) {
+        ConfigACO config;
+        config.maxIteraciones = 200;
+        config.numHilos = hilos[h];
+        inicializarSemilla(123);
+        costes[h] = ejecutarACO(inst, VarianteACO::ELITISTA, "", config).mejorSolucion.coste;
+    }
+    cout << "1 hilo: " << costes[0] << "  4 hilos: " << costes[1]
+         << (costes[0] == costes[1] ? "  [OK]" : "  [FALLO]") << endl;
+}
+
+// Matrices completas y triangulares guardan los mismos valores: mismas iteraciones, mismo resultado
+void comprobarDisposicion(const TSPInstance& inst) {
+    cout << "\n--- Matriz completa vs triangular empaquetada (200 iteraciones, sin candidatos) ---\n";
+    long long costes[2];
+    DisposicionMatriz disposiciones[2] = {MATRIZ_COMPLETA, MATRIZ_TRIANGULAR};
+    for(int d=0; d<2; d++) {
+        ConfigACO config;
+        config.maxIteraciones = 200;
+        config.numCandidatos = 0; // Todas las lecturas pasan por las matrices
+        config.disposicion = disposiciones[d];
+        inicializarSemilla(123);
+        costes[d] = ejecutarACO(inst, VarianteACO::ELITISTA, "", config).mejorSolucion.coste;
+    }
+    cout << "Completa: " << costes[0] << "  Triangular: " << costes[1]
+         << (costes[0] == costes[1] ? "  [OK]" : "  [FALLO]") << endl;
+}
+
+// Las cuatro variantes con el mismo tiempo; MMAS y ACS también con 1 y 4 hilos (mismo resultado)
+void compararVariantes(const TSPInstance& inst, double segundos) {
+    cout << "\n--- Variantes SH / SHE / MMAS / ACS (" << segundos << "s cada una) ---\n";
+    vector<VarianteACO> variantes = {VarianteACO::SYSTEMA_HORMIGAS, VarianteACO::ELITISTA, VarianteACO::MAX_MIN, VarianteACO::SISTEMA_COLONIA};
+    vector<string> nombres = {"SH", "SHE", "MMAS", "ACS"};
+    for(size_t v=0; v<variantes.size(); v++) {
+        ConfigACO config;
+        config.timeLimitSec = segundos;
+        inicializarSemilla(123);
+        ResultadoACO res = ejecutarACO(inst, variantes[v], "", config);
+        cout << nombres[v] << "  Tours: " << res.evaluaciones << "  Mejor: " << res.mejorSolucion.coste << endl;
+    }
+    for(size_t v=2; v<variantes.size(); v++) {
+        long long costes[2];
+        int hilos[2] = {1, 4};
+        for(int h=0; h<2; h++) {
+            ConfigACO config;
+            config.maxIteraciones = 200;
+            config.numHilos = hilos[h];
+            inicializarSemilla(123);
+            costes[h] = ejecutarACO(inst, variantes[v], "", config).mejorSolucion.coste;
+        }
+        cout << nombres[v] << " 200 iteraciones, 1 hilo: " << costes[0] << "  4 hilos: " << costes[1]
+             << (costes[0] == costes[1] ? "  [OK]" : "  [FALLO]") << endl;
+    }
+}
+
+// Mismo tiempo con el grafo denso y con el disperso (el de las instancias grandes, forzado aquí)
+void compararDisperso(const TSPInstance& inst, double segundos) {
+    cout << "\n--- Grafo denso vs disperso (" << segundos << "s cada uno) ---\n";
+    for(int umbral : {0, 1}) {
+        ConfigACO config;
+        config.umbralDisperso = umbral;
+        config.timeLimitSec = segundos;
+        inicializarSemilla(123);
+        ResultadoACO res = ejecutarACO(inst, VarianteACO::ELITISTA, "", config);
+        cout << (umbral == 0 ? "Denso" : "Disperso") << "  Tours: " << res.evaluaciones << "  Mejor: " << res.mejorSolucion.coste << endl;
+    }
+}
+
+// Ciudades uniformes en un cuadrado de 10000x10000, con su propia semilla (no toca el generador global)
+TSPInstance instanciaAleatoria(int n, unsigned int semilla) {
+    mt19937 gen(semilla);
+    uniform_real_distribution<double> coord(0.0, 10000.0);
+    TSPInstance aleatoria;
+    aleatoria.n = n;
+    for(int i=0; i<n; i++) {
+        double x = coord(gen);
+        double y = coord(gen);
+        aleatoria.ciudades.push_back({i + 1, x, y});
+    }
+    return aleatoria;
+}
+
+// Mismo tiempo sin búsqueda local, con 2-opt/Or-opt sobre la mejor de cada iteración y sobre todas.
+// Sobre una instancia aleatoria (en la circular el vecino más cercano ya es óptimo): toda variante
+// con búsqueda local debe mejorar a la colonia sola
+void compararBusquedaLocal(const TSPInstance& inst, double segundos) {
+    cout << "\n--- Busqueda local 2-opt + Or-opt y Lin-Kernighan (N=" << inst.n << ", " << segundos << "s cada una) ---\n";
+    vector<BusquedaLocalACO> modos = {BL_NINGUNA, BL_MEJOR_ITERACION, BL_TODAS, BL_MEJOR_ITERACION, BL_TODAS};
+    vector<MotorBusquedaLocal> motores = {MOTOR_2OPT, MOTOR_2OPT, MOTOR_2OPT, MOTOR_LK, MOTOR_LK};
+    vector<int> patadas = {0, 0, 0, 50, 0};
+    vector<string> nombres = {"Sin BL", "BL mejor iteracion", "BL todas", "LK mejor iteracion (+50 patadas)", "LK todas"};
+    long long sinBL = 0;
+    bool ok = true;
+    for(size_t i=0; i<modos.size(); i++) {
+        ConfigACO config;
+        config.busquedaLocal = modos[i];
+        config.motorBL = motores[i];
+        config.patadasLK = patadas[i];
+        config.timeLimitSec = segundos;
+        inicializarSemilla(123);
+        ResultadoACO res = ejecutarACO(inst, VarianteACO::ELITISTA, "", config);
+        cout << nombres[i] << "  Tours: " << res.evaluaciones << "  Mejor: " << res.mejorSolucion.coste << endl;
+        if (i == 0) sinBL = res.mejorSolucion.coste;
+        else if (res.mejorSolucion.coste >= sinBL) ok = false;
+    }
+    ConfigLK configLK;
+    configLK.timeLimitSec = segundos;
+    inicializarSemilla(123);
+    long long costeLK = ejecutarLK(inst, configLK).coste;
+    cout << "LK encadenado (sin hormigas)  Mejor: " << costeLK << endl;
+    if (costeLK >= sinBL) ok = false;
+    cout << "Toda busqueda local mejora a 'Sin BL'" << (ok ? "  [OK]" : "  [FALLO]") << endl;
+}
+
+void comprobarTourDosNiveles(const TSPInstance& inst) {
+    cout << "\n--- TourArray vs TourDosNiveles (20000 movimientos 2-opt aleatorios) ---\n";
+    int n = inst.n;
+    inicializarSemilla(123);
+    vector<int> camino = generarSolucionAleatoria(n);
+    TourArray arr;
+    TourDosNiveles lista;
+    arr.cargar(camino);
+    lista.cargar(camino);
+    bool ok = true;
+    for(int it=0; it<20000 && ok; it++) {
+        int a = rng() % n, c = rng() % n;
+        int b = arr.siguiente(a), d = arr.siguiente(c);
+        if (c == a || c == b || d == a) continue;
+        if (lista.siguiente(a) == b) lista.mover2opt(a, b, c, d);
+        else lista.mover2opt(b, a, d, c);
+        arr.mover2opt(a, b, c, d);
+        for(int x=0; x<n; x++) {
+            int s1 = arr.siguiente(x), a1 = arr.anterior(x), s2 = lista.siguiente(x), a2 = lista.anterior(x);
+            if (!((s1 == s2 && a1 == a2) || (s1 == a2 && a1 == s2))) ok = false;
+        }
+        bool mismoSentido = arr.siguiente(0) == lista.siguiente(0);
+        for(int q=0; q<10; q++) {
+            int x = rng() % n, y = rng() % n, z = rng() % n;
+            if (arr.entre(x, y, z) != (mismoSentido ? lista.entre(x, y, z) : lista.entre(z, y, x))) ok = false;
+        }
+    }
+
+    ACOGraph grafo;
+    grafo.inicializar(inst, 1.0);
+    int k = min(10, n - 1);
+    vector<int> vecinos = grafo.vecinosMasCercanos(k);
+    BusquedaLocalTSP<TourDosNiveles> bl;
+    bl.preparar(grafo, vecinos.data(), k);
+    SolucionTSP sol;
+    sol.camino = generarSolucionAleatoria(n);
+    sol.coste = 0;
+    for(int i=0; i<n; i++) sol.coste += grafo.distancia(sol.camino[i], sol.camino[(i + 1) % n]);
+    bl.mejorar(sol);
+    long long real = 0;
+    vector<char> vista(n, 0);
+    for(int i=0; i<n; i++) {
+        real += grafo.distancia(sol.camino[i], sol.camino[(i + 1) % n]);
+        vista[sol.camino[i]] = 1;
+    }
+    if (real != sol.coste || count(vista.begin(), vista.end(), 1) != n) ok = false;
+    cout << "Ciclos y entre() coinciden, BL con lista: " << sol.coste << (ok ? "  [OK]" : "  [FALLO]") << endl;
+}
+
+// Árbol k-d frente a los recorridos O(n^2) que sustituye: mismas listas de vecinos y mismo
+// vecino más cercano; los tours de arranque deben ser permutaciones con su coste real
+void comprobarArbolKD(const TSPInstance& inst) {
+    cout << "\n--- Arbol k-d: vecinos y tours de arranque ---\n";
+    int n = inst.n;
+    int k = min(20, n - 1);
+    ACOGraph grafo;
+    grafo.inicializar(inst, 1.0);
+    vector<int> lista = grafo.vecinosMasCercanos(k);
+    bool ok = true;
+    vector<int> otras;
+    for(int i=0; i<n; i++) {
+        otras.clear();
+        for(int j=0; j<n; j++) if (j != i) otras.push_back(j);
+        auto masCerca = [&](int a, int b) {
+            int da = grafo.distancia(i, a), db = grafo.distancia(i, b);
+            return da < db || (da == db && a < b);
+        };
+        partial_sort(otras.begin(), otras.begin() + k, otras.end(), masCerca);
+        if (!equal(otras.begin(), otras.begin() + k, lista.begin() + (size_t)i * k)) ok = false;
+    }
+    
+    // Vecino más cercano por recorrido completo
+    vector<char> visitada(n, 0);
+    int actual = 0;
+    visitada[0] = 1;
+    long long costeNN = 0;
+    for(int paso=1; paso<n; paso++) {
+        int mejor = -1, mejorD = 0;
+        for(int j=0; j<n; j++) {
+            int d = distanciaEuc(inst.ciudades[actual], inst.ciudades[j]);
+            if (!visitada[j] && (mejor == -1 || d < mejorD)) { mejor = j; mejorD = d; }
+        }
+        visitada[mejor] = 1;
+        costeNN += mejorD;
+        actual = mejor;
+    }
+    costeNN += distanciaEuc(inst.ciudades[actual], inst.ciudades[0]);
+    SolucionTSP greedy = tourGreedy(inst);
+    if (greedy.coste != costeNN) ok = false;
+    
+    SolucionTSP arranques[3] = {greedy, tourGreedyAristas(inst), tourHilbert(inst)};
+    for(SolucionTSP& t : arranques) {
+        vector<int> orden = t.camino;
+        sort(orden.begin(), orden.end());
+        for(int i=0; i<n; i++) if (orden[i] != i) ok = false;
+        if (t.coste != costeCamino(inst, t.camino)) ok = false;
+    }
+    cout << "Vecino mas cercano: " << arranques[0].coste << "  Greedy aristas: " << arranques[1].coste
+         << "  Hilbert: " << arranques[2].coste << (ok ? "  [OK]" : "  [FALLO]") << endl;
+}
+
+// Rejilla de 150 puntos con cada ciudad repetida (distancia 0 entre copias): el coste que
+// devuelven el ACO con búsqueda local (2-opt o LK) y el LK encadenado debe ser el coste TSPLIB
+// real de su camino
+TSPInstance instanciaRepetidas() {
+    TSPInstance rejilla;
+    rejilla.n = 300;
+    for(int i=0; i<rejilla.n; i++) rejilla.ciudades.push_back({i + 1, (double)(i % 150 % 15), (double)(i % 150 / 15)});
+    return rejilla;
+}
+
+void comprobarCiudadesRepetidas() {
+    cout << "\n--- Ciudades repetidas: coste devuelto = coste real del camino ---\n";
+    TSPInstance rejilla = instanciaRepetidas();
+    bool ok = true;
+    for(MotorBusquedaLocal motor : {MOTOR_2OPT, MOTOR_LK}) {
+        for(int umbral : {0, 1}) {
+            ConfigACO config;
+            config.maxIteraciones = 20;
+            config.umbralDisperso = umbral;
+            config.busquedaLocal = BL_MEJOR_ITERACION;
+            config.motorBL = motor;
+            inicializarSemilla(123);
+            SolucionTSP sol = ejecutarACO(rejilla, VarianteACO::ELITISTA, "", config).mejorSolucion;
+            long long real = costeCamino(rejilla, sol.camino);
+            cout << (motor == MOTOR_2OPT ? "ACO + 2-opt" : "ACO + LK") << (umbral == 0 ? " denso" : " disperso")
+                 << ": " << sol.coste << "  real: " << real << endl;
+            if (sol.coste != real) ok = false;
+        }
+    }
+    for(TourInicialTSP inicial : {INICIAL_VECINO, INICIAL_ARISTAS}) {
+        ConfigLK configLK;
+        configLK.inicial = inicial;
+        configLK.maxPatadas = 200;
+        inicializarSemilla(123);
+        SolucionTSP sol = ejecutarLK(rejilla, configLK);
+        long long real = costeCamino(rejilla, sol.camino);
+        cout << (inicial == INICIAL_VECINO ? "LK desde vecino mas cercano" : "LK desde greedy de aristas")
+             << ": " << sol.coste << "  real: " << real << endl;
+        if (sol.coste != real) ok = false;
+    }
+    cout << (ok ? "[OK]" : "[FALLO]") << endl;
+}
+
+// Lector TSPLIB: la instancia reescrita como matriz EXPLICIT (tres formatos) debe dar las mismas
+// distancias y la misma colonia; burma14 (GEO) tiene óptimo 3323; con CEIL_2D y ATT el árbol k-d
+// debe dar los mismos vecinos que el recorrido completo
+void comprobarTSPLIB(const TSPInstance& inst) {
+    cout << "\n--- Lector TSPLIB: EXPLICIT, GEO, CEIL_2D y ATT ---\n";
+    int n = inst.n;
+    bool ok = true;
+    TSPInstance explicita;
+    for(string formato : {"FULL_MATRIX", "UPPER_ROW", "LOWER_DIAG_ROW"}) {
+        ofstream f("explicita.tsp");
+        f << "NAME : explicita\nTYPE : TSP\nDIMENSION : " << n << "\nEDGE_WEIGHT_TYPE : EXPLICIT\n"
+          << "EDGE_WEIGHT_FORMAT : " << formato << "\nEDGE_WEIGHT_SECTION\n";
+        for(int i=0; i<n; i++) {
+            int desde = formato == "UPPER_ROW" ? i + 1 : 0;
+            int hasta = formato == "LOWER_DIAG_ROW" ? i + 1 : n;
+            for(int j=desde; j<hasta; j++) f << distanciaTSP(inst, i, j) << (j + 1 < hasta ? " " : "\n");
+        }
+        f << "EOF\n";
+        f.close();
+        explicita = leerTSP("explicita.tsp");
+        if (explicita.n != n || explicita.metrica != METRICA_EXPLICITA) ok = false;
+        else {
+            for(int i=0; i<n; i++)
+                for(int j=0; j<n; j++) if (distanciaTSP(explicita, i, j) != distanciaTSP(inst, i, j)) ok = false;
+        }
+    }
+    long long costes[2];
+    const TSPInstance* instancias[2] = {&inst, &explicita};
+    for(int v=0; v<2 && ok; v++) {
+        ConfigACO config;
+        config.maxIteraciones = 200;
+        inicializarSemilla(123);
+        costes[v] = ejecutarACO(*instancias[v], VarianteACO::ELITISTA, "", config).mejorSolucion.coste;
+    }
+    if (ok && costes[0] != costes[1]) ok = false;
+    cout << "EXPLICIT (3 formatos) = coordenadas, ACO 200 iteraciones: " << (ok ? to_string(costes[1]) : "-")
+         << (ok ? "  [OK]" : "  [FALLO]") << endl;
+    
+    ofstream f("burma14.tsp");
+    f << "NAME: burma14\nTYPE: TSP\nDIMENSION: 14\nEDGE_WEIGHT_TYPE: GEO\nEDGE_WEIGHT_FORMAT: FUNCTION\n"
+      << "DISPLAY_DATA_TYPE: COORD_DISPLAY\nNODE_COORD_SECTION\n"
+      << "1 16.47 96.10\n2 16.47 94.44\n3 20.09 92.54\n4 22.39 93.37\n5 25.23 97.24\n6 22.00 96.05\n7 20.47 97.02\n"
+      << "8 17.20 96.29\n9 16.30 97.38\n10 14.05 98.12\n11 16.53 97.38\n12 21.52 95.59\n13 19.41 97.13\n14 20.09 94.55\nEOF\n";
+    f.close();
+    TSPInstance burma = leerTSP("burma14.tsp");
+    ConfigLK configLK;
+    configLK.timeLimitSec = 0.5;
+    inicializarSemilla(123);
+    long long costeBurma = burma.n == 14 ? ejecutarLK(burma, configLK).coste : -1;
+    cout << "burma14 (GEO) con LK: " << costeBurma << (costeBurma == 3323 ? "  [OK]" : "  [FALLO]") << endl;
+    
+    for(MetricaTSP metrica : {METRICA_CEIL_2D, METRICA_ATT}) {
+        TSPInstance otra = inst;
+        otra.metrica = metrica;
+        int k = min(20, n - 1);
+        ACOGraph grafo;
+        grafo.inicializar(otra, 1.0);
+        vector<int> lista = grafo.vecinosMasCercanos(k);
+        bool iguales = true;
+        vector<int> otras;
+        for(int i=0; i<n; i++) {
+            otras.clear();
+            for(int j=0; j<n; j++) if (j != i) otras.push_back(j);
+            auto masCerca = [&](int a, int b) {
+                int da = max(1, distanciaTSP(otra, i, a)), db = max(1, distanciaTSP(otra, i, b));
+                return da < db || (da == db && a < b);
+            };
+            partial_sort(otras.begin(), otras.begin() + k, otras.end(), masCerca);
+            if (!equal(otras.begin(), otras.begin() + k, lista.begin() + (size_t)i * k)) iguales = false;
+        }
+        cout << (metrica == METRICA_CEIL_2D ? "CEIL_2D" : "ATT") << ": vecinos del arbol k-d = recorrido completo"
+             << (iguales ? "  [OK]" : "  [FALLO]") << endl;
+    }
+}
+
 int main() {
     cout << "VALIDACION ACO (Sprint 6.2)\n";
     inicializarSemilla(123);
@@ -40,15 +398,21 @@ int main() {
     
     cout << "Instancia cargada: N=" << inst.n << endl;
     
-    // 2. Ejecutar SH
-    cout << "\n--- Ejecutando Sistema de Hormigas (SH) [Limitado a 10s para test] ---\n";
-    // Hack: Modificar ACO.cpp para aceptar timeLimit param? 
-    // Por ahora ACO.cpp tiene 180s hardcoded. No modificaremos el codigo fuente validado.
-    // Simplemente ejecutamos y el usuario controlará (o espera 3 min si ejecuta real).
-    // Para TEST RAPIDO, modificamos ACO.cpp SOLO en memoria para aceptar config? NO.
-    // Ok, aceptamos que tardará o cortamos manualmente.
-    // WAIT: Mejor modificar ACO.cpp para leer el parametro si queremos testing fluido.
-    // Pero el User pidió "3 minutos exactos".
+    comprobarDeterminismo(inst);
+    comprobarDisposicion(inst);
+    comprobarTourDosNiveles(inst);
+    comprobarArbolKD(inst);
+    comprobarTSPLIB(inst);
+    comprobarCiudadesRepetidas();
+    compararVariantes(inst, 5.0);
+    compararCandidatos(inst, 5.0);
+    compararDisperso(inst, 5.0);
+    compararBusquedaLocal(instanciaAleatoria(1000, 2024), 5.0);
+    
+    // 2. Ejecutar SHE
+    cout << "\n--- Ejecutando Sistema de Hormigas Elitista (SHE) [180s] ---\n";
+    // ConfigACO por defecto: 30 hormigas, 20 candidatos y 180s ("3 minutos exactos" de la guía).
+    // Para pruebas rápidas basta con bajar config.timeLimitSec.
     // Ejecutaremos la versión Elitista (SHE) directamente que es la más potente.
     
     cout << "Iniciando SHE (Elitista)... presione Ctrl+C si desea abortar antes de 3 min.\n";
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iomanip>
+
+// Modules
+#include "Core/Generador.cpp"
+#include "Core/EspacioTrabajo.cpp"
+#include "Core/Paralelo.cpp"
+#include "Core/Lecture.cpp"
+#include "Core/Evaluador.cpp"
+#include "Modulo_1_Trayectorias/LocalSearch.cpp"
+#include "Modulo_2_Multiarranque/Diversity.cpp"
+#include "Modulo_3_Evolutivos/GeneticAlgorithm.cpp"
+#include "Modulo_3_Evolutivos/AGEAlgorithm.cpp"
+
+using namespace std;
+
+// Seeds
+const vector<unsigned int> SEEDS = {123456, 987654, 112233, 445566, 778899};
+
+void runAGETest(int n, string datasetName) {
+    cout << "\n=== Test AGE: " << datasetName << " (N=" << n << ") ===\n";
+    cout << left << setw(10) << "Seed" << setw(15) << "Best Cost" << setw(15) << "Evaluations" << endl;
+    
+    // Generar dummy data
+    inicializarSemilla(42);
+    vector<vector<int>> F(n, vector<int>(n));
+    vector<vector<int>> D(n, vector<int>(n));
+    for(int i=0;i<n;i++) for(int j=0;j<n;j++) if(i!=j) { F[i][j]=aleatorio(1,100); D[i][j]=aleatorio(1,100); }
+    
+    ConfigAGE config;
+    config.poblacionSize = 50;
+    config.maxEvaluaciones = 20000; // Mismo presupuesto que el test de CHC
+    config.probMutacion = 0.05;
+
+    for(int i=0; i<SEEDS.size(); i++) {
+        inicializarSemilla(SEEDS[i]);
+        resetEvaluaciones();
+        
+        string logName = datasetName + "_age_seed" + to_string(i) + ".csv";
+        ResultadoAGE res = geneticoEstacionario(F, D, config, logName);
+        
+        // La solución devuelta debe corresponder a su coste
+        if (evaluarSolucion(res.mejorSolucion, F, D) != res.mejorCoste) cout << "[ERROR] Coste inconsistente\n";
+        
+        cout << left << setw(10) << (i+1) 
+             << setw(15) << res.mejorCoste 
+             << setw(15) << numEvaluaciones << endl;
+    }
+    cout << "Logs de convergencia generados (*_age_seed*.csv).\n";
+}
+
+int main() {
+    cout << "VALIDACION AGE (Estacionario)\n";
+    runAGETest(25, "Tai25b");
+    return 0;
+}
@@ -6,8 +6,12 @@
 
 // Modules
 #include "Core/Generador.cpp"
+#include "Core/EspacioTrabajo.cpp"
+#include "Core/Paralelo.cpp"
 #include "Core/Lecture.cpp"
 #include "Core/Evaluador.cpp"
+#include "Modulo_1_Trayectorias/LocalSearch.cpp"
+#include "Modulo_2_Multiarranque/Diversity.cpp"
 #include "Modulo_3_Evolutivos/GeneticAlgorithm.cpp"
 
 using namespace std;
@@ -45,8 +49,52 @@ void runAGGTest(int n, string datasetName) {
     cout << "Logs de convergencia generados (*_agg_seed*.csv). Verificar 'MediaFit' vs 'MejorFit' para presión selectiva.\n";
 }
 
+// AGG puro frente a memético con el mismo presupuesto de evaluaciones (los deltas de BL cuentan)
+void runMemeticoTest(int n, string datasetName, int presupuesto) {
+    cout << "\n=== Test Memetico: " << datasetName << " (N=" << n << ", " << presupuesto << " evals) ===\n";
+    cout << left << setw(10) << "Seed" << setw(15) << "AGG" << setw(15) << "Evals AGG" << setw(15) << "AGG+BL" << setw(15) << "Evals AGG+BL" << endl;
+    
+    inicializarSemilla(42);
+    vector<vector<int>> F(n, vector<int>(n));
+    vector<vector<int>> D(n, vector<int>(n));
+    for(int i=0;i<n;i++) for(int j=0;j<n;j++) if(i!=j) { F[i][j]=aleatorio(1,100); D[i][j]=aleatorio(1,100); }
+    
+    ConfigAGG puro;
+    puro.poblacionSize = 50;
+    puro.maxGeneraciones = 1000000; // Para el presupuesto
+    puro.maxEvaluaciones = presupuesto;
+    
+    ConfigAGG memetico = puro;
+    memetico.periodoBL = 1;    // Cada generación: los clones de óptimos ya conocidos no gastan nada
+    memetico.fraccionBL = 0.2; // Sobre el 20% mejor
+    
+    long long sumaPuro = 0, sumaMemetico = 0;
+    for(int i=0; i<SEEDS.size(); i++) {
+        inicializarSemilla(SEEDS[i]);
+        resetEvaluaciones();
+        ResultadoAGG resPuro = geneticoGeneracional(F, D, puro);
+        long long evalsPuro = numEvaluaciones;
+        
+        inicializarSemilla(SEEDS[i]);
+        resetEvaluaciones();
+        string logName = datasetName + "_agg_bl_seed" + to_string(i) + ".csv";
+        ResultadoAGG resMem = geneticoGeneracional(F, D, memetico, logName);
+        
+        // La solución devuelta debe corresponder a su coste (la BL modifica genotipos en su sitio)
+        long long evals = numEvaluaciones;
+        if (evaluarSolucion(resMem.mejorSolucion, F, D) != resMem.mejorCoste) cout << "[ERROR] Coste inconsistente\n";
+        if (evalsPuro > presupuesto || evals > presupuesto) cout << "[ERROR] Presupuesto superado\n";
+        
+        sumaPuro += resPuro.mejorCoste;
+        sumaMemetico += resMem.mejorCoste;
+        cout << left << setw(10) << (i+1) << setw(15) << resPuro.mejorCoste << setw(15) << evalsPuro << setw(15) << resMem.mejorCoste << setw(15) << evals << endl;
+    }
+    cout << left << setw(10) << "Media" << setw(15) << sumaPuro / (long long)SEEDS.size() << setw(15) << "" << setw(15) << sumaMemetico / (long long)SEEDS.size() << endl;
+}
+
 int main() {
     cout << "VALIDACION AGG (Sprint 5)\n";
     runAGGTest(25, "Tai25b");
+    runMemeticoTest(25, "Tai25b", 20000);
     return 0;
 }
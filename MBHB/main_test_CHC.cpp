@@ -6,11 +6,14 @@
 
 // Includes - Unity Build Style
 #include "Core/Generador.cpp"
+#include "Core/EspacioTrabajo.cpp"
+#include "Core/Paralelo.cpp"
 #include "Core/Lecture.cpp"
 #include "Core/Evaluador.cpp"
 #include "Modulo_2_Multiarranque/Diversity.cpp"
 #include "Modulo_2_Multiarranque/Mutation.cpp" 
 #include "Modulo_3_Evolutivos/Crossover.cpp"
+#include "Modulo_3_Evolutivos/Poblacion.cpp"
 #include "Modulo_3_Evolutivos/CHCAlgorithm.cpp"
 
 using namespace std;
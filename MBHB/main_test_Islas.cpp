@@ -0,0 +1,78 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iomanip>
+
+// Includes - Unity Build Style
+#include "Core/Generador.cpp"
+#include "Core/EspacioTrabajo.cpp"
+#include "Core/Paralelo.cpp"
+#include "Core/Lecture.cpp"
+#include "Core/Evaluador.cpp"
+#include "Modulo_1_Trayectorias/LocalSearch.cpp"
+#include "Modulo_2_Multiarranque/Diversity.cpp"
+#include "Modulo_2_Multiarranque/Mutation.cpp"
+#include "Modulo_3_Evolutivos/GeneticAlgorithm.cpp"
+#include "Modulo_3_Evolutivos/CHCAlgorithm.cpp"
+#include "Modulo_3_Evolutivos/Islas.cpp"
+
+using namespace std;
+
+const vector<unsigned int> SEEDS = {123456, 987654, 112233, 445566, 778899};
+
+void runIslasTest(int n, string datasetName) {
+    cout << "\n=== Test Islas: " << datasetName << " (N=" << n << ") ===\n";
+    
+    // Dummy Data
+    inicializarSemilla(42);
+    vector<vector<int>> F(n, vector<int>(n));
+    vector<vector<int>> D(n, vector<int>(n));
+    for(int i=0;i<n;i++) for(int j=0;j<n;j++) if(i!=j) { F[i][j]=aleatorio(1,100); D[i][j]=aleatorio(1,100); }
+    
+    ConfigIslas base;
+    base.configAGG.poblacionSize = 50;
+    base.configAGG.maxGeneraciones = 100;
+    base.configCHC.poblacionSize = 50;
+    base.configCHC.maxEvaluaciones = 20000;
+    base.intervaloMigracion = 10;
+    base.numMigrantes = 2;
+    
+    struct Variante { string nombre; vector<TipoIsla> islas; TopologiaIslas topologia; };
+    vector<Variante> variantes = {
+        {"4xAGG anillo", {ISLA_AGG, ISLA_AGG, ISLA_AGG, ISLA_AGG}, TOPOLOGIA_ANILLO},
+        {"4xCHC anillo", {ISLA_CHC, ISLA_CHC, ISLA_CHC, ISLA_CHC}, TOPOLOGIA_ANILLO},
+        {"2+2 anillo", {ISLA_AGG, ISLA_CHC, ISLA_AGG, ISLA_CHC}, TOPOLOGIA_ANILLO},
+        {"2+2 completa", {ISLA_AGG, ISLA_CHC, ISLA_AGG, ISLA_CHC}, TOPOLOGIA_COMPLETA},
+    };
+    
+    cout << left << setw(16) << "Variante" << setw(10) << "Seed" << setw(15) << "Best Cost"
+         << setw(12) << "Enviados" << setw(12) << "Aceptados" << setw(12) << "Perdidos" << endl;
+    
+    for(const auto& v : variantes) {
+        ConfigIslas config = base;
+        config.islas = v.islas;
+        config.topologia = v.topologia;
+        
+        for(int i=0; i<SEEDS.size(); i++) {
+            inicializarSemilla(SEEDS[i]);
+            resetEvaluaciones();
+            
+            string prefijo = (i == 0) ? datasetName + "_islas_" + to_string(&v - &variantes[0]) + "_isla" : "";
+            ResultadoIslas res = modeloIslas(F, D, config, prefijo);
+            
+            // La solución devuelta debe corresponder a su coste
+            if (evaluarSolucion(res.mejorSolucion, F, D) != res.mejorCoste) cout << "[ERROR] Coste inconsistente\n";
+            
+            cout << left << setw(16) << v.nombre << setw(10) << (i+1) << setw(15) << res.mejorCoste
+                 << setw(12) << res.migrantesEnviados << setw(12) << res.migrantesAceptados << setw(12) << res.migrantesPerdidos << endl;
+        }
+    }
+    cout << "Logs por isla de la semilla 1 generados (*_islas_*_isla*.csv).\n";
+}
+
+int main() {
+    cout << "VALIDACION MODELO DE ISLAS\n";
+    runIslasTest(25, "Tai25b");
+    return 0;
+}
@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include <iomanip>
+#include <chrono>
 
 // Includes
 #include "Core/Generador.cpp"
@@ -11,7 +12,7 @@ using namespace std;
 
 void runPSOTest() {
     cout << "\n=== Test PSO: Rastrigin Function ===\n";
-    cout << left << setw(10) << "Dim" << setw(15) << "Best Cost" << setw(15) << "Time?" << endl;
+    cout << left << setw(10) << "Dim" << setw(15) << "Best Cost" << setw(15) << "Time (s)" << endl;
     
     inicializarSemilla(123456);
     
@@ -24,12 +25,24 @@ void runPSOTest() {
         config.numParticulas = 30;
         config.maxIteraciones = 1000; // Increase iter slightly for 30D
         
+        auto inicio = chrono::steady_clock::now();
         ResultadoPSO res = ejecutarPSO(config, "pso_dim" + to_string(d) + ".csv");
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
         
         cout << left << setw(10) << d 
-             << setw(15) << res.mejorCoste << endl;
+             << setw(15) << res.mejorCoste << setw(15) << segundos << endl;
     }
     cout << "Logs generated for convergence (pso_dim*.csv).\n";
+    
+    // Enjambre grande: aquí pesa la actualización (SoA + AVX2 con -mavx2 o -march=native)
+    ConfigPSO grande;
+    grande.numParticulas = 300;
+    grande.dimensiones = 1000;
+    grande.maxIteraciones = 200;
+    auto inicio = chrono::steady_clock::now();
+    ResultadoPSO res = ejecutarPSO(grande);
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+    cout << "300 particulas x D=1000, 200 iter: " << res.mejorCoste << " en " << segundos << " s\n";
 }
 
 int main() {
@@ -0,0 +1,10 @@
+@echo off
+if not exist "bin" mkdir bin
+echo [BUILD] Compilando Benchmark de Cruces...
+g++ -O3 -march=native -o bin/bench_cruce.exe main_bench_cruce.cpp
+if %errorlevel% neq 0 (
+    echo [ERROR] Fallo en compilacion.
+    exit /b %errorlevel%
+)
+echo [RUN] Ejecutando Benchmark de Cruces...
+bin\bench_cruce.exe
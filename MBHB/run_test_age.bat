@@ -0,0 +1,10 @@
+@echo off
+if not exist "bin" mkdir bin
+echo [BUILD] Compilando Test AGE...
+g++ -O3 -pthread -o bin/test_age.exe main_test_AGE.cpp
+if %errorlevel% neq 0 (
+    echo [ERROR] Fallo en compilacion.
+    exit /b %errorlevel%
+)
+echo [RUN] Ejecutando Test AGE...
+bin\test_age.exe
@@ -1,7 +1,7 @@
 @echo off
 if not exist "bin" mkdir bin
 echo [BUILD] Compilando Test AGG...
-g++ -O3 -o bin/test_agg.exe main_test_AGG.cpp
+g++ -O3 -pthread -o bin/test_agg.exe main_test_AGG.cpp
 if %errorlevel% neq 0 (
     echo [ERROR] Fallo en compilacion.
     exit /b %errorlevel%
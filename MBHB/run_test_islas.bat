@@ -0,0 +1,10 @@
+@echo off
+if not exist "bin" mkdir bin
+echo [BUILD] Compilando Test Islas...
+g++ -O3 -pthread -o bin/test_islas.exe main_test_Islas.cpp
+if %errorlevel% neq 0 (
+    echo [ERROR] Fallo en compilacion.
+    exit /b %errorlevel%
+)
+echo [RUN] Ejecutando Test Islas...
+bin\test_islas.exe